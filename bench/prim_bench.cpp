@@ -0,0 +1,181 @@
+/**
+ * @file    prim_bench.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Times prim::generate() against the old frontier list, that removed a frontier with erase()
+ *          and retried random directions until one of them hit a carved cell.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */
+
+#include "prim.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+
+namespace
+{
+  constexpr uint8_t wall = maze::maze_generator::wall;
+  constexpr uint8_t hole = maze::maze_generator::hole;
+
+  constexpr uint32_t north  = 0u;
+  constexpr uint32_t south  = 1u;
+  constexpr uint32_t west   = 2u;
+  constexpr uint32_t east   = 3u;
+
+  struct frontier_location {
+    uint32_t y;
+    uint32_t x;
+  };
+
+  /**
+   * @brief   Old version: sets a hole at [y,x] and saves every walled neighbour as a frontier.
+   * @param   &target       - The maze.
+   * @param   &in_frontier  - One bit per cell, set when the cell becomes a frontier.
+   * @param   &frontiers    - The list of frontiers.
+   * @param   y             - Coordinate of the new hole.
+   * @param   x             - Coordinate of the new hole.
+   * @return  void
+   */
+  void old_mark(maze::grid &target, std::vector<bool> &in_frontier, std::vector<frontier_location> &frontiers, uint32_t y, uint32_t x)
+  {
+    size_t cells_per_row = target.get_width()/2u;
+    size_t cell = (y/2u)*cells_per_row + (x/2u);
+
+    target(y, x) = hole;
+    if ((y >= 3u) && (wall == target(y-2u, x)) && (!in_frontier[cell-cells_per_row]))
+    {
+      in_frontier[cell-cells_per_row] = true;
+      frontiers.push_back({y-2u, x});
+    }
+    if (((y+2u) <= target.get_height()-2u) && (wall == target(y+2u, x)) && (!in_frontier[cell+cells_per_row]))
+    {
+      in_frontier[cell+cells_per_row] = true;
+      frontiers.push_back({y+2u, x});
+    }
+    if ((x >= 3u) && (wall == target(y, x-2u)) && (!in_frontier[cell-1u]))
+    {
+      in_frontier[cell-1u] = true;
+      frontiers.push_back({y, x-2u});
+    }
+    if (((x+2u) <= target.get_width()-2u) && (wall == target(y, x+2u)) && (!in_frontier[cell+1u]))
+    {
+      in_frontier[cell+1u] = true;
+      frontiers.push_back({y, x+2u});
+    }
+  }
+
+  /**
+   * @brief   Old version of Prim's algorithm, as it was before the frontier list became O(1) per step.
+   * @param   &target - The maze, filled with walls.
+   * @param   seed    - Seed of Mersenne Twister 19937.
+   * @return  void
+   */
+  void old_prim(maze::grid &target, uint64_t seed)
+  {
+    std::mt19937 random_generator(static_cast<uint32_t>(seed));
+    std::uniform_int_distribution<uint32_t> random_start_y(1u, target.get_height()-2u);
+    std::uniform_int_distribution<uint32_t> random_start_x(1u, target.get_width()-2u);
+    std::uniform_int_distribution<uint32_t> random_dir(north, east);
+    std::vector<bool> in_frontier(static_cast<size_t>(target.get_height()/2u)*(target.get_width()/2u), false);
+    std::vector<frontier_location> frontiers;
+
+    old_mark(target, in_frontier, frontiers, random_start_y(random_generator)/2u*2u+1u, random_start_x(random_generator)/2u*2u+1u);
+
+    while (!frontiers.empty())
+    {
+      bool possible_to_crave = false;
+
+      std::uniform_int_distribution<uint32_t> random_frontier(0u, frontiers.size()-1u);
+      uint32_t next_frontier = random_frontier(random_generator);
+      uint32_t y = frontiers[next_frontier].y;
+      uint32_t x = frontiers[next_frontier].x;
+      frontiers.erase(frontiers.begin()+next_frontier);
+
+      while (!possible_to_crave)
+      {
+        uint32_t direction = random_dir(random_generator);
+        if ((north == direction) && (y > 2u) && (hole == target(y-2u, x)))
+        {
+          possible_to_crave = true;
+          target(y-1u, x) = hole;
+        }
+        else if ((south == direction) && ((y+2u) < (target.get_height()-1u)) && (hole == target(y+2u, x)))
+        {
+          possible_to_crave = true;
+          target(y+1u, x) = hole;
+        }
+        else if ((west == direction) && (x > 2u) && (hole == target(y, x-2u)))
+        {
+          possible_to_crave = true;
+          target(y, x-1u) = hole;
+        }
+        else if ((east == direction) && ((x+2u) < (target.get_width()-1u)) && (hole == target(y, x+2u)))
+        {
+          possible_to_crave = true;
+          target(y, x+1u) = hole;
+        }
+        else
+        {
+          /* Do nothing. */
+        }
+      }
+
+      old_mark(target, in_frontier, frontiers, y, x);
+    }
+  }
+
+  /**
+   * @brief   Returns the milliseconds since a point in time.
+   * @param   start - The point in time.
+   * @return  Milliseconds.
+   */
+  double elapsed(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+  }
+}
+
+/**
+ * @brief   Main function. Generates a square maze of every size with both versions, and prints the times.
+ *          The sizes can be given as arguments, by default 4001 and 8001.
+ * @param   argc - Number of arguments.
+ * @param   argv - The sizes (odd numbers).
+ * @return  0
+ */
+int32_t main(int32_t argc, char *argv[])
+{
+  std::vector<uint32_t> sizes = {4001u, 8001u};
+  const uint64_t seed = 1u;
+
+  if (1 < argc)
+  {
+    sizes.clear();
+    for (int32_t i = 1; i < argc; i++)
+    {
+      sizes.push_back(static_cast<uint32_t>(std::stoul(argv[i])));
+    }
+  }
+
+  std::cout << std::fixed << std::setprecision(0);
+  for (uint32_t size : sizes)
+  {
+    /* The constructor checks the size, so it comes first. */
+    maze::prim new_maze(size, size, seed);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    new_maze.generate();
+    double new_ms = elapsed(start);
+
+    maze::grid old_maze(size, size, wall);
+    start = std::chrono::steady_clock::now();
+    old_prim(old_maze, seed);
+    double old_ms = elapsed(start);
+
+    std::cout << size << "x" << size << ": old frontier list " << old_ms << " ms, prim::generate() " << new_ms << " ms, ";
+    std::cout << std::setprecision(1) << (old_ms/new_ms) << "x faster\n" << std::setprecision(0);
+  }
+
+  return 0;
+}
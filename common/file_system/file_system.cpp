@@ -10,24 +10,24 @@
 #include "file_system.h"
 
 /**
- * @brief   Resizes (20 times bigger) and then saves the input vector-vector as an image.
- * @param   vect      - 2D vector.
+ * @brief   Resizes (20 times bigger) and then saves the input grid as an image.
+ * @param   vect      - View of the maze.
  * @param   filename  - The filename and location.
  * @return  void
  */
-void maze::file_system::save(std::vector<std::vector<uint32_t>> vect, std::string filename)
+void maze::file_system::save(grid_view vect, std::string filename)
 {
-  /* Create a Mat with the same values as the input vector-vector. */
-  cv::Mat mat_vect(vect.size(), vect[0u].size(), CV_8UC3);
+  /* Create a Mat with the same values as the input grid. */
+  cv::Mat mat_vect(vect.get_height(), vect.get_width(), CV_8UC3);
   for(int32_t y = 0; y < mat_vect.rows; y++)
   { 
     for(int32_t x = 0; x < mat_vect.cols; x++)
     {
-      if (maze::maze_generator::wall == vect[y][x])
+      if (maze::maze_generator::wall == vect(y, x))
       {
         mat_vect.at<cv::Vec3b>(y, x) = black;
       }
-      else if (maze::maze_generator::hole == vect[y][x])
+      else if (maze::maze_generator::hole == vect(y, x))
       {
         mat_vect.at<cv::Vec3b>(y, x) = white;
       }
@@ -38,7 +38,7 @@ void maze::file_system::save(std::vector<std::vector<uint32_t>> vect, std::strin
     }
   }
   /* Create a bigger one. */
-  cv::Mat mat_vect_bigger(vect.size()*factor, vect[0u].size()*factor, CV_8UC3);
+  cv::Mat mat_vect_bigger(vect.get_height()*factor, vect.get_width()*factor, CV_8UC3);
   /* Resize the original. */
 	cv::resize(mat_vect, mat_vect_bigger, cv::Size(), factor, factor, cv::INTER_NEAREST);
   /* Save. */
@@ -46,38 +46,36 @@ void maze::file_system::save(std::vector<std::vector<uint32_t>> vect, std::strin
 }
 
 /**
- * @brief   Loads an image, resizes it (20 times smaller) and then returns it as a vector-vector.
+ * @brief   Loads an image, resizes it (20 times smaller) and then returns it as a grid.
  * @param   filename  - The filename and location.
- * @return  vect      - vector-vector of the input image.
+ * @return  vect      - Grid of the input image.
  */
-std::vector<std::vector<uint32_t>> maze::file_system::load(std::string filename)
+maze::grid maze::file_system::load(std::string filename)
 {
   /* Load. */
   cv::Mat mat_vect = cv::imread(filename, cv::IMREAD_COLOR);
   /* Create a smaller one. */
   cv::Mat mat_vect_smaller(cv::Size(mat_vect.cols/factor, mat_vect.rows/factor), CV_8UC3);
-  std::vector<std::vector<uint32_t>> vect;
   /* Resize the original. */
 	cv::resize(mat_vect, mat_vect_smaller, cv::Size(mat_vect.cols/factor, mat_vect.rows/factor), cv::INTER_NEAREST);
 
-  /* Convert it a vector-vector. */
-  vect.resize(mat_vect_smaller.rows);
+  /* Convert it a grid. */
+  grid vect(mat_vect_smaller.rows, mat_vect_smaller.cols, maze::maze_generator::wall);
   for(int32_t y = 0; y < mat_vect_smaller.rows; y++)
   { 
-    vect[y].resize(mat_vect_smaller.cols);
     for(int32_t x = 0; x < mat_vect_smaller.cols; x++)
     {
       if (black == mat_vect_smaller.at<cv::Vec3b>(y, x))
       {
-        vect[y][x] = maze::maze_generator::wall;
+        vect(y, x) = maze::maze_generator::wall;
       }
       else if (white == mat_vect_smaller.at<cv::Vec3b>(y, x))
       {
-        vect[y][x] = maze::maze_generator::hole;
+        vect(y, x) = maze::maze_generator::hole;
       }
       else
       {
-        vect[y][x] = maze::maze_generator::solution;
+        vect(y, x) = maze::maze_generator::solution;
       }
     }
   }
@@ -85,3 +83,130 @@ std::vector<std::vector<uint32_t>> maze::file_system::load(std::string filename)
   return vect;
 }
 
+/**
+ * @brief   Resizes (20 times bigger) and then saves the input grid as an image, with the terrain:
+ *          mud is brown, water is blue, the other holes are white.
+ * @param   vect      - View of the maze.
+ * @param   costs     - View of the costs of the cells, with the same size as the maze.
+ * @param   filename  - The filename and location.
+ * @return  void
+ */
+void maze::file_system::save(grid_view vect, grid_view costs, std::string filename)
+{
+  if ((vect.get_height() != costs.get_height()) || (vect.get_width() != costs.get_width()))
+  {
+    throw std::invalid_argument("The costs must have the same size as the maze.");
+  }
+
+  /* Create a Mat with the same values as the input grid. */
+  cv::Mat mat_vect(vect.get_height(), vect.get_width(), CV_8UC3);
+  for(int32_t y = 0; y < mat_vect.rows; y++)
+  { 
+    for(int32_t x = 0; x < mat_vect.cols; x++)
+    {
+      if (maze::maze_generator::wall == vect(y, x))
+      {
+        mat_vect.at<cv::Vec3b>(y, x) = black;
+      }
+      else if (maze::maze_generator::hole != vect(y, x))
+      {
+        mat_vect.at<cv::Vec3b>(y, x) = red;
+      }
+      else if (mud_cost == costs(y, x))
+      {
+        mat_vect.at<cv::Vec3b>(y, x) = brown;
+      }
+      else if (water_cost == costs(y, x))
+      {
+        mat_vect.at<cv::Vec3b>(y, x) = blue;
+      }
+      else
+      {
+        mat_vect.at<cv::Vec3b>(y, x) = white;
+      }
+    }
+  }
+  /* Create a bigger one. */
+  cv::Mat mat_vect_bigger(vect.get_height()*factor, vect.get_width()*factor, CV_8UC3);
+  /* Resize the original. */
+  cv::resize(mat_vect, mat_vect_bigger, cv::Size(), factor, factor, cv::INTER_NEAREST);
+  /* Save. */
+  imwrite(filename, mat_vect_bigger);
+}
+
+/**
+ * @brief   Loads an image like load() above, and the terrain from its colours too: brown is mud and blue is water.
+ *          They are holes in the maze, only their costs are higher.
+ * @param   filename  - The filename and location.
+ * @param   costs     - Cost of every cell: wall_cost, hole_cost, mud_cost or water_cost.
+ * @return  vect      - Grid of the input image.
+ */
+maze::grid maze::file_system::load(std::string filename, grid &costs)
+{
+  /* Load. */
+  cv::Mat mat_vect = cv::imread(filename, cv::IMREAD_COLOR);
+  /* Create a smaller one. */
+  cv::Mat mat_vect_smaller(cv::Size(mat_vect.cols/factor, mat_vect.rows/factor), CV_8UC3);
+  /* Resize the original. */
+  cv::resize(mat_vect, mat_vect_smaller, cv::Size(mat_vect.cols/factor, mat_vect.rows/factor), cv::INTER_NEAREST);
+
+  /* Convert it a grid. */
+  grid vect(mat_vect_smaller.rows, mat_vect_smaller.cols, maze::maze_generator::wall);
+  costs = grid(mat_vect_smaller.rows, mat_vect_smaller.cols, wall_cost);
+  for(int32_t y = 0; y < mat_vect_smaller.rows; y++)
+  { 
+    for(int32_t x = 0; x < mat_vect_smaller.cols; x++)
+    {
+      const cv::Vec3b &colour = mat_vect_smaller.at<cv::Vec3b>(y, x);
+      if (black == colour)
+      {
+        vect(y, x) = maze::maze_generator::wall;
+        costs(y, x) = wall_cost;
+      }
+      else if (brown == colour)
+      {
+        vect(y, x) = maze::maze_generator::hole;
+        costs(y, x) = mud_cost;
+      }
+      else if (blue == colour)
+      {
+        vect(y, x) = maze::maze_generator::hole;
+        costs(y, x) = water_cost;
+      }
+      else if (white == colour)
+      {
+        vect(y, x) = maze::maze_generator::hole;
+        costs(y, x) = hole_cost;
+      }
+      else
+      {
+        vect(y, x) = maze::maze_generator::solution;
+        costs(y, x) = hole_cost;
+      }
+    }
+  }
+
+  return vect;
+}
+
+/**
+ * @brief   Writes the header of a binary PGM image, then returns a sink, that writes the rows of the maze after it.
+ *          The rows aren't resized and nothing is kept in memory, so it works with mazes, that wouldn't fit into it.
+ * @param   &output - The stream of the image (file, socket, ...). It must outlive the sink.
+ * @param   height  - Height of the maze.
+ * @param   width   - Width of the maze.
+ * @return  The sink.
+ */
+maze::row_sink maze::file_system::stream(std::ostream &output, uint64_t height, uint32_t width)
+{
+  output << "P5\n" << width << " " << height << "\n255\n";
+  std::vector<char> pixels(width);
+  return [&output, pixels](const uint8_t *row, uint32_t row_width) mutable
+  {
+    for (uint32_t x = 0u; x < row_width; x++)
+    {
+      pixels[x] = (maze::maze_generator::wall == row[x]) ? 0 : static_cast<char>(255u);
+    }
+    output.write(pixels.data(), row_width);
+  };
+}
@@ -20,14 +20,25 @@ namespace maze
   class file_system
   {
     public:
-      void save(std::vector<std::vector<uint32_t>> vect, std::string filename);
-      std::vector<std::vector<uint32_t>> load(std::string filename);
+      void save(grid_view vect, std::string filename);
+      void save(grid_view vect, grid_view costs, std::string filename);
+      grid load(std::string filename);
+      grid load(std::string filename, grid &costs);
+      row_sink stream(std::ostream &output, uint64_t height, uint32_t width);
+
+      /* Cost of stepping into a cell of the terrain. 0 can't be entered at all. */
+      static constexpr uint8_t wall_cost  = 0u;
+      static constexpr uint8_t hole_cost  = 1u;
+      static constexpr uint8_t mud_cost   = 3u;
+      static constexpr uint8_t water_cost = 8u;
 
     private:
       static constexpr uint32_t factor = 20u;
       const cv::Vec3b white = cv::Vec3b(255u, 255u, 255u);
       const cv::Vec3b black = cv::Vec3b(0u, 0u, 0u);
       const cv::Vec3b red   = cv::Vec3b(0u,0u,255u);
+      const cv::Vec3b brown = cv::Vec3b(19u, 69u, 139u);
+      const cv::Vec3b blue  = cv::Vec3b(255u, 0u, 0u);
   };
 }
 
@@ -0,0 +1,119 @@
+/**
+ * @file    grid.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Flat, row-major storage of a maze.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "grid.h"
+
+/**
+ * @brief   Constructor. Creates an empty grid.
+ * @param   void
+ * @return  void
+ */
+maze::grid::grid(void) : height(0u), width(0u), stride(0u)
+{
+}
+
+/**
+ * @brief   Constructor. Creates a single buffer for every cell, filled with the same value.
+ * @param   height - Height of the grid.
+ * @param   width  - Width of the grid.
+ * @param   value  - Initial value of every cell.
+ * @return  void
+ */
+maze::grid::grid(uint32_t height, uint32_t width, uint8_t value) : height(height), width(width), stride(width)
+{
+  cells.assign(static_cast<size_t>(height)*width, value);
+}
+
+/**
+ * @brief   Changes the dimensions. The old cells keep their place, the new ones get the given value.
+ * @param   new_height - New height of the grid.
+ * @param   new_width  - New width of the grid.
+ * @param   value      - Value of the new cells.
+ * @return  void
+ */
+void maze::grid::resize(uint32_t new_height, uint32_t new_width, uint8_t value)
+{
+  std::vector<uint8_t> new_cells(static_cast<size_t>(new_height)*new_width, value);
+
+  /* Copy the overlapping part row by row. */
+  uint32_t copy_height = (height < new_height) ? height : new_height;
+  uint32_t copy_width  = (width < new_width) ? width : new_width;
+  for (uint32_t y = 0u; y < copy_height; y++)
+  {
+    for (uint32_t x = 0u; x < copy_width; x++)
+    {
+      new_cells[static_cast<size_t>(y)*new_width + x] = cells[static_cast<size_t>(y)*stride + x];
+    }
+  }
+
+  cells.swap(new_cells);
+  height = new_height;
+  width  = new_width;
+  stride = new_width;
+}
+
+/**
+ * @brief   Returns a view of the whole grid. It stays valid until the grid is resized or destroyed.
+ * @param   void
+ * @return  View of the grid.
+ */
+maze::grid_view maze::grid::view(void)
+{
+  return grid_view(cells.data(), height, width, stride);
+}
+
+/**
+ * @brief   Returns the first cell of the buffer.
+ * @param   void
+ * @return  Pointer to the cell at [0,0].
+ */
+uint8_t *maze::grid::data(void)
+{
+  return cells.data();
+}
+
+/**
+ * @brief   Returns the first cell of the buffer.
+ * @param   void
+ * @return  Pointer to the cell at [0,0].
+ */
+const uint8_t *maze::grid::data(void) const
+{
+  return cells.data();
+}
+
+/**
+ * @brief   Returns the height of the grid.
+ * @param   void
+ * @return  height
+ */
+uint32_t maze::grid::get_height(void) const
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the grid.
+ * @param   void
+ * @return  width
+ */
+uint32_t maze::grid::get_width(void) const
+{
+  return width;
+}
+
+/**
+ * @brief   Returns the distance (in cells) between the start of two rows.
+ * @param   void
+ * @return  stride
+ */
+uint32_t maze::grid::get_stride(void) const
+{
+  return stride;
+}
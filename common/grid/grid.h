@@ -0,0 +1,91 @@
+/**
+ * @file    grid.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Flat, row-major storage of a maze.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef GRID_H_
+#define GRID_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+namespace maze
+{
+  /* Receives the finished rows of a maze, one by one, from the top. */
+  typedef std::function<void(const uint8_t *row, uint32_t width)> row_sink;
+
+  /**
+   * Non-owning view of a maze: pointer to the first cell, dimensions and stride.
+   * It is cheap to copy, so it can be passed by value instead of the maze itself.
+   */
+  class grid_view
+  {
+    public:
+      grid_view(uint8_t *data, uint32_t height, uint32_t width, uint32_t stride) : cells(data), height(height), width(width), stride(stride) {}
+
+      uint8_t &operator()(uint32_t y, uint32_t x) const
+      {
+        return cells[static_cast<size_t>(y)*stride + x];
+      }
+
+      uint8_t *data(void) const         { return cells; }
+      uint32_t get_height(void) const   { return height; }
+      uint32_t get_width(void) const    { return width; }
+      uint32_t get_stride(void) const   { return stride; }
+
+    private:
+      uint8_t *cells;
+      uint32_t height;
+      uint32_t width;
+      uint32_t stride;
+  };
+
+  class grid
+  {
+    public:
+      grid(void);
+      explicit grid(uint32_t height, uint32_t width, uint8_t value);
+
+      /**
+       * @brief   Returns a cell. Row y starts at y*stride, so a neighbour is only +-1 or +-stride away.
+       * @param   y - The y coordinate of the cell.
+       * @param   x - The x coordinate of the cell.
+       * @return  Reference to the cell.
+       */
+      uint8_t &operator()(uint32_t y, uint32_t x)
+      {
+        return cells[static_cast<size_t>(y)*stride + x];
+      }
+
+      const uint8_t &operator()(uint32_t y, uint32_t x) const
+      {
+        return cells[static_cast<size_t>(y)*stride + x];
+      }
+
+      void resize(uint32_t new_height, uint32_t new_width, uint8_t value);
+
+      grid_view view(void);
+      operator grid_view(void) { return view(); }
+
+      uint8_t *data(void);
+      const uint8_t *data(void) const;
+
+      uint32_t get_height(void) const;
+      uint32_t get_width(void) const;
+      uint32_t get_stride(void) const;
+
+    private:
+      uint32_t height;
+      uint32_t width;
+      uint32_t stride;
+      std::vector<uint8_t> cells;
+  };
+}
+
+#endif /* GRID_H_ */
@@ -9,6 +9,7 @@
 
 #include "aldous_broder.h"
 #include "binary_tree.h"
+#include "eller.h"
 #include "kruskal.h"
 #include "prim.h"
 #include "recursive_backtracking.h"
@@ -19,6 +20,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <ctime>
+#include <fstream>
 #include "file_system.h"
 
 /**
@@ -33,9 +35,10 @@ int32_t main(void)
   uint32_t algorithm    = 0u;
   std::string filename  = "output/";
   time_t current_time   = 0u;
+  uint64_t seed         = 0u;
   maze::file_system m_file_system;
   maze::solver m_solver;
-  std::vector<std::vector<uint32_t>> maze;
+  maze::grid maze;
   
   std::cout << "\n--------------------------------\n";
   std::cout << "   Maze generation algorithms\n";
@@ -52,6 +55,7 @@ int32_t main(void)
   std::cout << "Prim's ------------------- 4\n";
   std::cout << "Recursive backtracking --- 5\n";
   std::cout << "Recursive division ------- 6\n";
+  std::cout << "Eller's (streamed) ------- 7\n";
   std::cout << "Select an algorithm: ";
   std::cin  >> algorithm;
 
@@ -67,9 +71,10 @@ int32_t main(void)
     m_maze.set_cell(0u,1u, m_maze.hole);                  /**< Entrance point at top-left. */
     m_maze.set_cell(height-1u, width-2u, m_maze.hole);    /**< Exit point at bottom-right. */
     m_maze.generate();                                    /**< The actual generation. */
+    seed = m_maze.get_seed();                             /**< The same seed gives the same maze again. */
     filename += "_Aldous_Broder.png";                     /**< Add the name of the algorithm into the filename. */
-    maze = m_maze.get_maze();                             /**< Get the maze. */
-    m_file_system.save(maze, filename);                   /**< Save. */
+    m_file_system.save(m_maze.view(), filename);          /**< Save, without copying the maze. */
+    maze = m_maze.take_maze();                            /**< Move the maze out, the generator isn't needed anymore. */
     m_solver.dijkstra(maze, 0u, 1u, height-1u, width-2u); /**< Solve it. */
     filename.insert(filename.size()-4u, "_Solved");       /**< Rename the filename. */
     m_file_system.save(maze, filename);                   /**< Save again. */
@@ -80,9 +85,10 @@ int32_t main(void)
     m_maze.set_cell(0u,1u, m_maze.hole);
     m_maze.set_cell(height-1u, width-2u, m_maze.hole);
     m_maze.generate();
+    seed = m_maze.get_seed();
     filename += "_Binary_tree.png";
-    maze = m_maze.get_maze();
-    m_file_system.save(maze, filename);
+    m_file_system.save(m_maze.view(), filename);
+    maze = m_maze.take_maze();
     m_solver.dijkstra(maze, 0u, 1u, height-1u, width-2u);
     filename.insert(filename.size()-4u, "_Solved");
     m_file_system.save(maze, filename);
@@ -93,9 +99,10 @@ int32_t main(void)
     m_maze.set_cell(0u,1u, m_maze.hole);
     m_maze.set_cell(height-1u, width-2u, m_maze.hole);
     m_maze.generate();
+    seed = m_maze.get_seed();
     filename += "_Kruskal.png";
-    maze = m_maze.get_maze();
-    m_file_system.save(maze, filename);
+    m_file_system.save(m_maze.view(), filename);
+    maze = m_maze.take_maze();
     m_solver.dijkstra(maze, 0u, 1u, height-1u, width-2u);
     filename.insert(filename.size()-4u, "_Solved");
     m_file_system.save(maze, filename);
@@ -106,9 +113,10 @@ int32_t main(void)
     m_maze.set_cell(0u,1u, m_maze.hole);
     m_maze.set_cell(height-1u, width-2u, m_maze.hole);
     m_maze.generate();
+    seed = m_maze.get_seed();
     filename += "_Prim.png";
-    maze = m_maze.get_maze();
-    m_file_system.save(maze, filename);
+    m_file_system.save(m_maze.view(), filename);
+    maze = m_maze.take_maze();
     m_solver.dijkstra(maze, 0u, 1u, height-1u, width-2u);
     filename.insert(filename.size()-4u, "_Solved");
     m_file_system.save(maze, filename);
@@ -119,9 +127,10 @@ int32_t main(void)
     m_maze.set_cell(0u,1u, m_maze.hole);
     m_maze.set_cell(height-1u, width-2u, m_maze.hole);
     m_maze.generate();
+    seed = m_maze.get_seed();
     filename += "_Recursive_backtracking.png";
-    maze = m_maze.get_maze();
-    m_file_system.save(maze, filename);
+    m_file_system.save(m_maze.view(), filename);
+    maze = m_maze.take_maze();
     m_solver.dijkstra(maze, 0u, 1u, height-1u, width-2u);
     filename.insert(filename.size()-4u, "_Solved");
     m_file_system.save(maze, filename);
@@ -132,19 +141,32 @@ int32_t main(void)
     m_maze.set_cell(0u,1u, m_maze.hole);
     m_maze.set_cell(height-1u, width-2u, m_maze.hole);
     m_maze.generate();
+    seed = m_maze.get_seed();
     filename += "_Recursive_division.png";
-    maze = m_maze.get_maze();
-    m_file_system.save(maze, filename);
+    m_file_system.save(m_maze.view(), filename);
+    maze = m_maze.take_maze();
     m_solver.dijkstra(maze, 0u, 1u, height-1u, width-2u);
     filename.insert(filename.size()-4u, "_Solved");
     m_file_system.save(maze, filename);
   }
+  else if (7u == algorithm)
+  {
+    /* Streamed row by row into a PGM image, the maze is never in the memory, so it isn't solved. */
+    maze::eller m_maze(height, width);
+    m_maze.set_entrance(1u);
+    m_maze.set_exit(width-2u);
+    filename += "_Eller.pgm";
+    std::ofstream file(filename, std::ios::binary);
+    m_maze.generate(m_file_system.stream(file, height, width));
+    seed = m_maze.get_seed();
+  }
   else
   {
     throw std::invalid_argument("Wrong algorithm number!");
   }
 
-  std::cout << "\nMaze generated and saved!\n\n";
+  std::cout << "\nMaze generated and saved!\n";
+  std::cout << "Seed: " << seed << "\n\n";
 
   return 0;
 }
@@ -10,12 +10,23 @@
 #include "maze_generator.h"
 
 /**
- * @brief   Constructor. Generates a 2D vector, which represents the maze.
+ * @brief   Constructor. Generates a flat grid, which represents the maze. The seed comes from the random device.
  * @param   height - Height of the maze.
  * @param   width  - Width of the maze.
  * @return  void
  */
-maze::maze_generator::maze_generator(uint32_t height, uint32_t width)
+maze::maze_generator::maze_generator(uint32_t height, uint32_t width) : maze_generator(height, width, random_seed())
+{
+}
+
+/**
+ * @brief   Constructor. Generates a flat grid, which represents the maze.
+ * @param   height - Height of the maze.
+ * @param   width  - Width of the maze.
+ * @param   seed   - Seed of the random generators. The same seed always gives the same maze.
+ * @return  void
+ */
+maze::maze_generator::maze_generator(uint32_t height, uint32_t width, uint64_t seed) : seed(seed)
 {
   /* Make sure, that the dimensions are odd numbers, otherwise the maze would look strange. */
   if ((!(height%2u)) || (!(width%2u)))
@@ -24,15 +35,7 @@ maze::maze_generator::maze_generator(uint32_t height, uint32_t width)
   }
 
   /* Create an area filled with walls. */
-  area.resize(height);
-  for (uint32_t y = 0u; y < height; y++)
-  {
-    area[y].resize(width);
-    for (uint32_t x = 0u; x < width; x++)
-    {
-      area[y][x] = wall;
-    }
-  }
+  area = grid(height, width, wall);
 }
 
 /**
@@ -44,7 +47,7 @@ maze::maze_generator::maze_generator(uint32_t height, uint32_t width)
  */
 void maze::maze_generator::set_cell(uint32_t y, uint32_t x, uint32_t value)
 {
-  if ((area.size() <= y) || (area[y].size() <= x))
+  if ((area.get_height() <= y) || (area.get_width() <= x))
   {
     throw std::invalid_argument("Out of boundary!");
   }
@@ -54,7 +57,7 @@ void maze::maze_generator::set_cell(uint32_t y, uint32_t x, uint32_t value)
   } 
   else
   { 
-    area[y][x] = value;
+    area(y, x) = value;
   }
 }
 
@@ -66,49 +69,107 @@ void maze::maze_generator::set_cell(uint32_t y, uint32_t x, uint32_t value)
  */
 uint32_t maze::maze_generator::get_cell(uint32_t y, uint32_t x)
 {
-  return area[y][x];
+  return area(y, x);
 }
 
 /**
  * @brief   Returns the maze.
  * @param   void
- * @return  area - 2D vector of the maze. 1 represents a hole, 0 represents a wall.
+ * @return  area - Grid of the maze. 1 represents a hole, 0 represents a wall.
  */
-std::vector<std::vector<uint32_t>> maze::maze_generator::get_maze(void)
+maze::grid maze::maze_generator::get_maze(void)
 {
   return area;
 }
 
 /**
- * @brief   Overwrites the current maze.
- * @param   vect - 2D vector of the maze. 1 represents a hole, 0 represents a wall.
+ * @brief   Overwrites the current maze with a copy.
+ * @param   &vect - Grid of the maze. 1 represents a hole, 0 represents a wall.
+ * @return  void
+ */
+void maze::maze_generator::set_maze(const grid &vect)
+{
+  check_maze(vect);
+  area = vect;
+}
+
+/**
+ * @brief   Overwrites the current maze by taking over the input, without copying it.
+ * @param   &&vect - Grid of the maze. 1 represents a hole, 0 represents a wall.
+ * @return  void
+ */
+void maze::maze_generator::set_maze(grid &&vect)
+{
+  check_maze(vect);
+  area = std::move(vect);
+}
+
+/**
+ * @brief   Returns a view of the maze, without copying it.
+ *          It stays valid until the maze is reshaped, overwritten or taken.
+ * @param   void
+ * @return  View of the maze.
+ */
+maze::grid_view maze::maze_generator::view(void)
+{
+  return area.view();
+}
+
+/**
+ * @brief   Moves the maze out of the generator, without copying it.
+ *          The generator is left without a maze, until set_maze() or reshape() gives it a new one.
+ *          Until then generate() throws, and set_maze() accepts any size.
+ * @param   void
+ * @return  area - Grid of the maze. 1 represents a hole, 0 represents a wall.
+ */
+maze::grid maze::maze_generator::take_maze(void)
+{
+  grid taken = std::move(area);
+  area = grid();
+  return taken;
+}
+
+/**
+ * @brief   Makes sure, that the input can be used as the maze.
+ *          If the maze has been taken, then any size is accepted.
+ * @param   &vect - Grid of the maze. 1 represents a hole, 0 represents a wall.
  * @return  void
  */
-void maze::maze_generator::set_maze(std::vector<std::vector<uint32_t>> vect)
+void maze::maze_generator::check_maze(const grid &vect)
 {
-  if ((vect.size() != area.size()) || (vect[0u].size() != area[0u].size()))
+  if ((0u != area.get_height()) && ((vect.get_height() != area.get_height()) || (vect.get_width() != area.get_width())))
   {
     throw std::invalid_argument("Wrong size!");
   }
   else
   { 
-    for (uint32_t y = 0u; y < vect.size(); y++)
+    for (uint32_t y = 0u; y < vect.get_height(); y++)
     {
-      for (uint32_t x = 0u; x < vect[y].size(); x++)
+      for (uint32_t x = 0u; x < vect.get_width(); x++)
       {
-        if ((wall != vect[y][x]) && (hole != vect[y][x]))
+        if ((wall != vect(y, x)) && (hole != vect(y, x)))
         {
           throw std::invalid_argument("The input can only contain 0 or 1.");
         }
-        else
-        {
-          area[y][x] = vect[y][x];
-        }
       }
     }
   }
 }
 
+/**
+ * @brief   Makes sure, that there is a maze to generate into.
+ *          After take_maze() there is none, until reshape() or set_maze() gives the generator a new one.
+ * @param   void
+ * @return  void
+ */
+void maze::maze_generator::check_area(void)
+{
+  if (0u == area.get_height())
+  {
+    throw std::invalid_argument("The maze has been taken, reshape or set it first!");
+  }
+}
+
 /**
  * @brief   Reshapes the maze.
  * @param   height - New height of the maze.
@@ -124,11 +185,7 @@ void maze::maze_generator::reshape(uint32_t height, uint32_t width)
   }
 
   /* Resize. */
-  area.resize(height);
-  for (uint32_t y = 0u; y < height; y++)
-  {
-    area[y].resize(width);
-  }
+  area.resize(height, width, wall);
 }
 
 /**
@@ -138,7 +195,7 @@ void maze::maze_generator::reshape(uint32_t height, uint32_t width)
  */
 uint32_t maze::maze_generator::get_height(void)
 {
-  return area.size();
+  return area.get_height();
 }
 
 /**
@@ -148,6 +205,36 @@ uint32_t maze::maze_generator::get_height(void)
  */
 uint32_t maze::maze_generator::get_width(void)
 {
-  return area[0u].size();
+  return area.get_width();
 }
 
+/**
+ * @brief   Changes the seed of the next generation.
+ * @param   new_seed - The new seed. The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::maze_generator::set_seed(uint64_t new_seed)
+{
+  seed = new_seed;
+}
+
+/**
+ * @brief   Returns the seed, so a maze can be reproduced later.
+ * @param   void
+ * @return  seed
+ */
+uint64_t maze::maze_generator::get_seed(void)
+{
+  return seed;
+}
+
+/**
+ * @brief   Returns a new seed from the random device. It is only called, when no seed is given.
+ * @param   void
+ * @return  64 random bits.
+ */
+uint64_t maze::maze_generator::random_seed(void)
+{
+  std::random_device random_device;
+  return (static_cast<uint64_t>(random_device()) << 32u) | random_device();
+}
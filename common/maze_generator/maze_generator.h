@@ -15,6 +15,9 @@
 #include <random>
 #include <algorithm>
 #include <stdexcept>
+#include "grid.h"
+#include "packed_grid.h"
+#include "random.h"
 
 namespace maze
 {
@@ -22,24 +25,34 @@ namespace maze
   {
     public:
       explicit maze_generator(uint32_t height, uint32_t width);
+      explicit maze_generator(uint32_t height, uint32_t width, uint64_t seed);
 
-      static constexpr uint32_t wall     = 0u;
-      static constexpr uint32_t hole     = 1u;
-      static constexpr uint32_t solution = 2u;
+      static constexpr uint8_t wall     = 0u;
+      static constexpr uint8_t hole     = 1u;
+      static constexpr uint8_t solution = 2u;
 
       void set_cell(uint32_t y, uint32_t x, uint32_t value);
       uint32_t get_cell(uint32_t y, uint32_t x);
 
-      std::vector<std::vector<uint32_t>> get_maze(void);
-      void set_maze(std::vector<std::vector<uint32_t>> vect);
+      grid get_maze(void);
+      void set_maze(const grid &vect);
+      void set_maze(grid &&vect);
+
+      grid_view view(void);
+      grid take_maze(void); /**< Leaves the generator empty: reshape() or set_maze() it, before generate() is called again. */
 
       void reshape(uint32_t new_height, uint32_t new_width);
 
       uint32_t get_height(void);
       uint32_t get_width(void);
 
+      void set_seed(uint64_t new_seed);
+      uint64_t get_seed(void);
+
+      static uint64_t random_seed(void);
+
     protected:
-      std::random_device random_device;
+      uint64_t seed; /**< The maze only depends on the algorithm, the dimensions and this. */
 
       static constexpr uint32_t vertical    = 0u;
       static constexpr uint32_t horizontal  = 1u;
@@ -49,9 +62,10 @@ namespace maze
       static constexpr uint8_t west   = 2u;
       static constexpr uint8_t east   = 3u;
 
-      std::vector<std::vector<uint32_t>> area;
+      grid area;
 
-      
+      void check_maze(const grid &vect);
+      void check_area(void);
   };
 }
 
@@ -0,0 +1,197 @@
+/**
+ * @file    packed_grid.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Bit-packed, edge-based storage of a maze.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "packed_grid.h"
+
+/**
+ * @brief   Constructor. Creates an empty maze.
+ * @param   void
+ * @return  void
+ */
+maze::packed_grid::packed_grid(void) : rows(0u), columns(0u)
+{
+}
+
+/**
+ * @brief   Constructor. Creates a maze full of walls, with 3 bits per cell.
+ * @param   height - Height of the maze (same as in grid, must be odd).
+ * @param   width  - Width of the maze (same as in grid, must be odd).
+ * @return  void
+ */
+maze::packed_grid::packed_grid(uint32_t height, uint32_t width) : rows(height/2u), columns(width/2u)
+{
+  if ((!(height%2u)) || (!(width%2u)))
+  {
+    throw std::invalid_argument("Height and width must be odd numbers!");
+  }
+
+  uint64_t words = ((static_cast<uint64_t>(rows)*columns)+63u)/64u;
+  open.assign(words, 0u);
+  east.assign(words, 0u);
+  south.assign(words, 0u);
+  north_border.assign((columns+63u)/64u, 0u);
+  west_border.assign((rows+63u)/64u, 0u);
+}
+
+/**
+ * @brief   Returns the value of a cell, the same way as grid would.
+ * @param   y - The y coordinate of the cell.
+ * @param   x - The x coordinate of the cell.
+ * @return  Either wall (0) or hole (1).
+ */
+uint8_t maze::packed_grid::get(uint32_t y, uint32_t x) const
+{
+  bool value = false;
+
+  if ((y & 1u) && (x & 1u))
+  {
+    /* A cell. */
+    value = bit(open, static_cast<uint64_t>(y >> 1u)*columns + (x >> 1u));
+  }
+  else if (y & 1u)
+  {
+    /* Between two cells horizontally, or the west boundary. */
+    if (0u == x)
+    {
+      value = bit(west_border, y >> 1u);
+    }
+    else
+    {
+      value = bit(east, static_cast<uint64_t>(y >> 1u)*columns + (x >> 1u) - 1u);
+    }
+  }
+  else if (x & 1u)
+  {
+    /* Between two cells vertically, or the north boundary. */
+    if (0u == y)
+    {
+      value = bit(north_border, x >> 1u);
+    }
+    else
+    {
+      value = bit(south, static_cast<uint64_t>((y >> 1u) - 1u)*columns + (x >> 1u));
+    }
+  }
+  else
+  {
+    /* Corner, always a wall. */
+  }
+
+  return value ? hole : wall;
+}
+
+/**
+ * @brief   Changes the value of a cell, the same way as grid would.
+ * @param   y     - The y coordinate of the cell.
+ * @param   x     - The x coordinate of the cell.
+ * @param   value - Either wall (0) or hole (1).
+ * @return  void
+ */
+void maze::packed_grid::set(uint32_t y, uint32_t x, uint8_t value)
+{
+  if ((wall != value) && (hole != value))
+  {
+    throw std::invalid_argument("The input can only contain 0 or 1.");
+  }
+
+  if ((y & 1u) && (x & 1u))
+  {
+    write_bit(open, static_cast<uint64_t>(y >> 1u)*columns + (x >> 1u), value);
+  }
+  else if (y & 1u)
+  {
+    if (0u == x)
+    {
+      write_bit(west_border, y >> 1u, value);
+    }
+    else
+    {
+      write_bit(east, static_cast<uint64_t>(y >> 1u)*columns + (x >> 1u) - 1u, value);
+    }
+  }
+  else if (x & 1u)
+  {
+    if (0u == y)
+    {
+      write_bit(north_border, x >> 1u, value);
+    }
+    else
+    {
+      write_bit(south, static_cast<uint64_t>((y >> 1u) - 1u)*columns + (x >> 1u), value);
+    }
+  }
+  else if (hole == value)
+  {
+    throw std::invalid_argument("The corners between the cells are always walls.");
+  }
+  else
+  {
+    /* Do nothing. */
+  }
+}
+
+/**
+ * @brief   Returns the height of the maze (same as in grid).
+ * @param   void
+ * @return  height
+ */
+uint32_t maze::packed_grid::get_height(void) const
+{
+  return rows*2u+1u;
+}
+
+/**
+ * @brief   Returns the width of the maze (same as in grid).
+ * @param   void
+ * @return  width
+ */
+uint32_t maze::packed_grid::get_width(void) const
+{
+  return columns*2u+1u;
+}
+
+/**
+ * @brief   Returns the number of cell rows.
+ * @param   void
+ * @return  rows
+ */
+uint32_t maze::packed_grid::get_rows(void) const
+{
+  return rows;
+}
+
+/**
+ * @brief   Returns the number of cell columns.
+ * @param   void
+ * @return  columns
+ */
+uint32_t maze::packed_grid::get_columns(void) const
+{
+  return columns;
+}
+
+/**
+ * @brief   Sets or clears a single bit.
+ * @param   &plane - The bits.
+ * @param   index  - Which bit.
+ * @param   value  - Either wall (0) or hole (1).
+ * @return  void
+ */
+void maze::packed_grid::write_bit(std::vector<uint64_t> &plane, uint64_t index, uint8_t value)
+{
+  uint64_t mask = static_cast<uint64_t>(1u) << (index & 63u);
+  if (hole == value)
+  {
+    plane[index >> 6u] |= mask;
+  }
+  else
+  {
+    plane[index >> 6u] &= ~mask;
+  }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file    packed_grid.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Bit-packed, edge-based storage of a maze.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef PACKED_GRID_H_
+#define PACKED_GRID_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+
+namespace maze
+{
+  /**
+   * The same coordinates are used as in grid: a maze with R*C cells is (2R+1)*(2C+1) big, the cells are on odd [y,x].
+   * But only the cells and the passages between them are stored, as bits:
+   *  - open:  the cell itself has been carved,
+   *  - east:  there is a passage between the cell and its east neighbour,
+   *  - south: there is a passage between the cell and its south neighbour.
+   * The corners between four cells are always walls. The outer boundary is stored separately (north row and west column),
+   * the east and south boundary are the east and south bits of the last column and row.
+   */
+  class packed_grid
+  {
+    public:
+      /* Reference to a single cell, so packed_grid can be used the same way as grid. */
+      class reference
+      {
+        public:
+          reference(packed_grid &owner, uint32_t y, uint32_t x) : owner(owner), y(y), x(x) {}
+          operator uint8_t(void) const { return owner.get(y, x); }
+          reference &operator=(uint8_t value) { owner.set(y, x, value); return *this; }
+          reference &operator=(const reference &other) { owner.set(y, x, static_cast<uint8_t>(other)); return *this; }
+
+        private:
+          packed_grid &owner;
+          uint32_t y;
+          uint32_t x;
+      };
+
+      packed_grid(void);
+      explicit packed_grid(uint32_t height, uint32_t width);
+
+      reference operator()(uint32_t y, uint32_t x)
+      {
+        return reference(*this, y, x);
+      }
+
+      uint8_t operator()(uint32_t y, uint32_t x) const
+      {
+        return get(y, x);
+      }
+
+      uint8_t get(uint32_t y, uint32_t x) const;
+      void set(uint32_t y, uint32_t x, uint8_t value);
+
+      bool is_open(uint64_t cell) const        { return bit(open, cell); }
+      bool is_open_east(uint64_t cell) const   { return bit(east, cell); }
+      bool is_open_south(uint64_t cell) const  { return bit(south, cell); }
+
+      uint32_t get_height(void) const;
+      uint32_t get_width(void) const;
+      uint32_t get_rows(void) const;
+      uint32_t get_columns(void) const;
+
+    private:
+      static constexpr uint8_t wall = 0u;
+      static constexpr uint8_t hole = 1u;
+
+      uint32_t rows;
+      uint32_t columns;
+      std::vector<uint64_t> open;
+      std::vector<uint64_t> east;
+      std::vector<uint64_t> south;
+      std::vector<uint64_t> north_border;
+      std::vector<uint64_t> west_border;
+
+      static bool bit(const std::vector<uint64_t> &plane, uint64_t index)
+      {
+        return (plane[index >> 6u] >> (index & 63u)) & 1u;
+      }
+
+      static void write_bit(std::vector<uint64_t> &plane, uint64_t index, uint8_t value);
+  };
+}
+
+#endif /* PACKED_GRID_H_ */
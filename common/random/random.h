@@ -0,0 +1,177 @@
+/**
+ * @file    random.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Small, fast pseudo-random generators for the maze generators.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace maze
+{
+  /**
+   * SplitMix64 pseudo-random generator. Every seed gives a good, independent stream,
+   * so it is used to derive new streams from a single seed.
+   * It can be used with the std:: distributions and algorithms.
+   */
+  class splitmix64
+  {
+    public:
+      typedef uint64_t result_type;
+
+      explicit splitmix64(uint64_t seed = 0u) : state(seed) {}
+
+      static constexpr result_type min(void) { return std::numeric_limits<result_type>::min(); }
+      static constexpr result_type max(void) { return std::numeric_limits<result_type>::max(); }
+
+      result_type operator()(void)
+      {
+        uint64_t z = (state += 0x9E3779B97F4A7C15u);
+        z = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9u;
+        z = (z ^ (z >> 27u)) * 0x94D049BB133111EBu;
+        return z ^ (z >> 31u);
+      }
+
+    private:
+      uint64_t state;
+  };
+
+  /**
+   * xoshiro256** pseudo-random generator. 256 bits of state, a few shifts and rotations per number.
+   * The state is filled from the seed with SplitMix64, as its authors recommend.
+   */
+  class xoshiro256starstar
+  {
+    public:
+      typedef uint64_t result_type;
+
+      explicit xoshiro256starstar(uint64_t seed = 0u)
+      {
+        splitmix64 seeder(seed);
+        for (uint64_t &word : state)
+        {
+          word = seeder();
+        }
+      }
+
+      static constexpr result_type min(void) { return std::numeric_limits<result_type>::min(); }
+      static constexpr result_type max(void) { return std::numeric_limits<result_type>::max(); }
+
+      result_type operator()(void)
+      {
+        uint64_t result = rotate(state[1u]*5u, 7u)*9u;
+        uint64_t shifted = state[1u] << 17u;
+        state[2u] ^= state[0u];
+        state[3u] ^= state[1u];
+        state[1u] ^= state[2u];
+        state[0u] ^= state[3u];
+        state[2u] ^= shifted;
+        state[3u] = rotate(state[3u], 45u);
+        return result;
+      }
+
+    private:
+      uint64_t state[4u];
+
+      static uint64_t rotate(uint64_t value, uint32_t bits) { return (value << bits) | (value >> (64u-bits)); }
+  };
+
+  /**
+   * PCG32 (XSH RR) pseudo-random generator. 64 bits of state, one multiplication per 32-bit number.
+   */
+  class pcg32
+  {
+    public:
+      typedef uint32_t result_type;
+
+      explicit pcg32(uint64_t seed = 0u) : state(0u)
+      {
+        (*this)();
+        state += seed;
+        (*this)();
+      }
+
+      static constexpr result_type min(void) { return std::numeric_limits<result_type>::min(); }
+      static constexpr result_type max(void) { return std::numeric_limits<result_type>::max(); }
+
+      result_type operator()(void)
+      {
+        uint64_t old_state = state;
+        state = old_state*6364136223846793005u + increment;
+        uint32_t xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        uint32_t rotation = static_cast<uint32_t>(old_state >> 59u);
+        return (xorshifted >> rotation) | (xorshifted << ((0u-rotation) & 31u));
+      }
+
+    private:
+      static constexpr uint64_t increment = 1442695040888963407u;
+      uint64_t state;
+  };
+
+  /**
+   * Creates a generator from a 64-bit seed. The generators above take it directly.
+   */
+  template <typename engine>
+  inline engine seeded(uint64_t seed)
+  {
+    return engine(seed);
+  }
+
+  /**
+   * Mersenne Twister 19937 only takes 32 bits directly, so both halves of the seed go through a seed sequence.
+   */
+  template <>
+  inline std::mt19937 seeded<std::mt19937>(uint64_t seed)
+  {
+    std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32u)};
+    return std::mt19937(sequence);
+  }
+
+  /**
+   * Returns 32 random bits: the upper half, if the generator gives 64 bits.
+   */
+  template <typename engine>
+  inline uint32_t random_bits(engine &generator)
+  {
+    if (UINT32_MAX < engine::max())
+    {
+      return static_cast<uint32_t>(static_cast<uint64_t>(generator()) >> 32u);
+    }
+    else
+    {
+      return static_cast<uint32_t>(generator());
+    }
+  }
+
+  /**
+   * Returns a uniform random number in [0, range), range must be at least 1.
+   * Multiplies instead of dividing (Lemire's method). The division only happens,
+   * when the result might be biased, which is rare for small ranges.
+   * Unlike the std:: distributions, it gives the same numbers with every standard library.
+   */
+  template <typename engine>
+  inline uint32_t bounded(engine &generator, uint32_t range)
+  {
+    uint64_t product = static_cast<uint64_t>(random_bits(generator))*range;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < range)
+    {
+      uint32_t threshold = (0u-range) % range;
+      while (low < threshold)
+      {
+        product = static_cast<uint64_t>(random_bits(generator))*range;
+        low = static_cast<uint32_t>(product);
+      }
+    }
+    return static_cast<uint32_t>(product >> 32u);
+  }
+}
+
+#endif /* RANDOM_H_ */
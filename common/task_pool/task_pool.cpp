@@ -0,0 +1,169 @@
+/**
+ * @file    task_pool.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Work-stealing pool of threads, for splitting a generation into independent tasks, and a barrier for threads working in steps.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "task_pool.h"
+
+/* The queue of the current thread. The threads outside of run() use the first one. */
+static thread_local uint32_t current_queue = 0u;
+
+/**
+ * @brief   Constructor. Creates one queue for every thread.
+ * @param   threads - Number of threads (including the one calling run()), 0 means every hardware thread.
+ * @return  void
+ */
+maze::task_pool::task_pool(uint32_t threads) : pending(0u)
+{
+  if (0u == threads)
+  {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (0u == threads)
+  {
+    threads = 1u;
+  }
+
+  for (uint32_t i = 0u; i < threads; i++)
+  {
+    queues.emplace_back(new task_queue);
+  }
+}
+
+/**
+ * @brief   Adds a new task. Can be called before run() or by a running task.
+ * @param   task - The task.
+ * @return  void
+ */
+void maze::task_pool::push(std::function<void(void)> task)
+{
+  task_queue &queue = *queues[current_queue % queues.size()];
+  pending++;
+  std::lock_guard<std::mutex> guard(queue.lock);
+  queue.tasks.push_back(std::move(task));
+}
+
+/**
+ * @brief   Runs every task, including the ones created meanwhile. The calling thread works too.
+ * @param   void
+ * @return  void
+ */
+void maze::task_pool::run(void)
+{
+  std::vector<std::thread> workers;
+  for (uint32_t i = 1u; i < queues.size(); i++)
+  {
+    workers.emplace_back(&task_pool::work, this, i);
+  }
+
+  work(0u);
+
+  for (uint32_t i = 0u; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+}
+
+/**
+ * @brief   Returns the number of threads.
+ * @param   void
+ * @return  threads
+ */
+uint32_t maze::task_pool::get_threads(void) const
+{
+  return queues.size();
+}
+
+/**
+ * @brief   The loop of a single thread. It stops, when there are no tasks left anywhere.
+ * @param   self - Index of the queue of this thread.
+ * @return  void
+ */
+void maze::task_pool::work(uint32_t self)
+{
+  std::function<void(void)> task;
+  uint32_t previous_queue = current_queue;
+  current_queue = self;
+
+  while (0u != pending)
+  {
+    if (take(self, task))
+    {
+      task();
+      task = nullptr;
+      pending--;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  current_queue = previous_queue;
+}
+
+/**
+ * @brief   Takes a task: the newest from its own queue, or the oldest from another one.
+ * @param   self  - Index of the queue of this thread.
+ * @param   &task - The task, that has been taken.
+ * @return  True if there was a task.
+ */
+bool maze::task_pool::take(uint32_t self, std::function<void(void)> &task)
+{
+  for (uint32_t i = 0u; i < queues.size(); i++)
+  {
+    task_queue &queue = *queues[(self+i) % queues.size()];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (!queue.tasks.empty())
+    {
+      if (0u == i)
+      {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      else
+      {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief   Constructor.
+ * @param   threads - Number of threads, that must arrive before any of them can continue.
+ * @return  void
+ */
+maze::thread_barrier::thread_barrier(uint32_t threads) : threads(threads)
+{
+}
+
+/**
+ * @brief   Waits for every thread. The last one runs a function, before the others are released.
+ * @param   &last - Run by the last thread to arrive, alone.
+ * @return  void
+ */
+void maze::thread_barrier::wait(const std::function<void(void)> &last)
+{
+  std::unique_lock<std::mutex> guard(lock);
+  uint64_t arrived = generation;
+  waiting++;
+  if (threads == waiting)
+  {
+    last();
+    waiting = 0u;
+    generation++;
+    released.notify_all();
+  }
+  else
+  {
+    released.wait(guard, [&]() { return generation != arrived; });
+  }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file    task_pool.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Work-stealing pool of threads, for splitting a generation into independent tasks, and a barrier for threads working in steps.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef TASK_POOL_H_
+#define TASK_POOL_H_
+
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace maze
+{
+  /**
+   * Every thread has its own queue. A thread takes the newest task from its own queue,
+   * or steals the oldest one from another thread, when its own queue is empty.
+   * A task can push new tasks, they go to the queue of the thread running it.
+   */
+  class task_pool
+  {
+    public:
+      explicit task_pool(uint32_t threads);
+
+      void push(std::function<void(void)> task);
+      void run(void);
+
+      uint32_t get_threads(void) const;
+
+    private:
+      struct task_queue {
+        std::mutex lock;
+        std::deque<std::function<void(void)>> tasks;
+      };
+
+      std::vector<std::unique_ptr<task_queue>> queues;
+      std::atomic<uint64_t> pending;
+
+      void work(uint32_t self);
+      bool take(uint32_t self, std::function<void(void)> &task);
+  };
+
+  /**
+   * The threads wait for each other, then continue together. The last one to arrive runs a step alone first,
+   * while the others are still waiting, so there is a serial part between the parallel ones without any other locking.
+   */
+  class thread_barrier
+  {
+    public:
+      explicit thread_barrier(uint32_t threads);
+
+      void wait(const std::function<void(void)> &last);
+
+    private:
+      std::mutex lock;
+      std::condition_variable released;
+      uint32_t threads;
+      uint32_t waiting = 0u;
+      uint64_t generation = 0u;
+  };
+}
+
+#endif /* TASK_POOL_H_ */
@@ -15,32 +15,95 @@
  * @return  void
  */
 void maze::aldous_broder::generate(void)
+{
+  check_area();
+  build<std::mt19937>(area);
+}
+
+/**
+ * @brief   This method generates the maze with Aldous-Broder algorithm, straight into a bit-packed maze.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+void maze::aldous_broder::generate(packed_grid &target)
+{
+  build<std::mt19937>(target);
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Aldous-Broder algorithm.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::aldous_broder::generate(uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate();
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Aldous-Broder algorithm, straight into a bit-packed maze.
+ * @param   &target  - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::aldous_broder::generate(packed_grid &target, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(target);
+}
+
+/**
+ * @brief   This method generates the maze with Aldous-Broder algorithm, using the selected pseudo-random generator.
+ * @param   void
+ * @return  void
+ */
+template <typename engine>
+void maze::aldous_broder::generate(void)
+{
+  check_area();
+  build<engine>(area);
+}
+
+/**
+ * @brief   This method generates the maze with Aldous-Broder algorithm, straight into a bit-packed maze, using the selected pseudo-random generator.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+template <typename engine>
+void maze::aldous_broder::generate(packed_grid &target)
+{
+  build<engine>(target);
+}
+
+/**
+ * @brief   The actual generation, the same for every kind of maze storage.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @return  void
+ */
+template <typename engine, typename surface>
+void maze::aldous_broder::build(surface &target)
 {
   uint32_t y = 0u;
   uint32_t x = 0u;
   /* The number of the cells, that can be visited. */
-  uint32_t total_cells = (area.size()/2u)*(area[0u].size()/2u);
+  uint32_t total_cells = (target.get_height()/2u)*(target.get_width()/2u);
 
-  /* Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
-  /* Random starting point. */
-  std::uniform_int_distribution<uint32_t> random_start_y(1u, area.size()-2u);
-  std::uniform_int_distribution<uint32_t> random_start_x(1u, area[0u].size()-2u);
-  /* Random direction. */
-  std::uniform_int_distribution<uint32_t> random_dir(north, east);
+  /* Pseudo-random generator, Mersenne Twister 19937 by default. */
+  engine random_generator = seeded<engine>(seed);
 
-  /* Make sure, that the two random numbers are odd. */
-  y = (random_start_y(random_generator)/2u*2u+1u);
-  x = (random_start_x(random_generator)/2u*2u+1u);
+  /* Random starting cell, its coordinates are odd numbers. */
+  y = bounded(random_generator, target.get_height()/2u)*2u+1u;
+  x = bounded(random_generator, target.get_width()/2u)*2u+1u;
   
-  area[y][x] = hole;
+  target(y, x) = hole;
   total_cells--;
 
   /* Loop until there are no cells left. */
   while(total_cells)
   {
     /* Randomly select a direction to move. */
-    uint32_t next_cell = random_dir(random_generator);
+    uint32_t next_cell = bounded(random_generator, 4u);
     
     if (north == next_cell)
     {
@@ -50,27 +113,27 @@ void maze::aldous_broder::generate(void)
         /* Save the new position. */
         y -= 2;
         /* In case the cell hasn't been visited, then change it to hole and lower the total_cell counter. */
-        if (wall == area[y][x])
+        if (wall == target(y, x))
         {
           total_cells--;
-          area[y][x] = hole;
-          area[y+1u][x] = hole;
+          target(y, x) = hole;
+          target(y+1u, x) = hole;
         }
       }
     }
     else if (south == next_cell)
     {
       /* Check if it is possible to go south. */
-      if ((y+2u) <= area.size()-2u)
+      if ((y+2u) <= target.get_height()-2u)
       {
         /* Save the new position. */
         y += 2;
         /* In case the cell hasn't been visited, then change it to hole and lower the total_cell counter. */
-        if (wall == area[y][x])
+        if (wall == target(y, x))
         {
           total_cells--;
-          area[y][x] = hole;
-          area[y-1u][x] = hole;
+          target(y, x) = hole;
+          target(y-1u, x) = hole;
         }
       }
     }
@@ -82,27 +145,27 @@ void maze::aldous_broder::generate(void)
         /* Save the new position. */
         x -= 2;
         /* In case the cell hasn't been visited, then change it to hole and lower the total_cell counter. */
-        if (wall == area[y][x])
+        if (wall == target(y, x))
         {
           total_cells--;
-          area[y][x] = hole;
-          area[y][x+1u] = hole;
+          target(y, x) = hole;
+          target(y, x+1u) = hole;
         }
       }
     }
     else if (east == next_cell)
     {
       /* Check if it is possible to go east. */
-      if ((x+2u) <= area[0u].size()-2u)
+      if ((x+2u) <= target.get_width()-2u)
       {
         /* Save the new position. */
         x += 2;
         /* In case the cell hasn't been visited, then change it to hole and lower the total_cell counter. */
-        if (wall == area[y][x])
+        if (wall == target(y, x))
         {
           total_cells--;
-          area[y][x] = hole;
-          area[y][x-1u] = hole;
+          target(y, x) = hole;
+          target(y, x-1u) = hole;
         }
       }
     }
@@ -114,3 +177,12 @@ void maze::aldous_broder::generate(void)
   }
 }
 
+/* Every pseudo-random generator, that can be selected. */
+template void maze::aldous_broder::generate<std::mt19937>(void);
+template void maze::aldous_broder::generate<maze::xoshiro256starstar>(void);
+template void maze::aldous_broder::generate<maze::pcg32>(void);
+template void maze::aldous_broder::generate<maze::splitmix64>(void);
+template void maze::aldous_broder::generate<std::mt19937>(packed_grid &target);
+template void maze::aldous_broder::generate<maze::xoshiro256starstar>(packed_grid &target);
+template void maze::aldous_broder::generate<maze::pcg32>(packed_grid &target);
+template void maze::aldous_broder::generate<maze::splitmix64>(packed_grid &target);
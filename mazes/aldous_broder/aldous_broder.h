@@ -19,6 +19,14 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(packed_grid &target);
+      void generate(uint64_t new_seed);
+      void generate(packed_grid &target, uint64_t new_seed);
+      template <typename engine> void generate(void);
+      template <typename engine> void generate(packed_grid &target);
+
+    private:
+      template <typename engine, typename surface> void build(surface &target);
   };
 }
 
@@ -11,41 +11,164 @@
 
 /**
  * @brief   This method generates the maze with binary tree algorithm.
+ *          The rows are independent, so they are split between as many threads, as set_threads() allows.
  * @param   void
  * @return  void
  */
 void maze::binary_tree::generate(void)
 {
-  /* Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
-  std::uniform_int_distribution<uint32_t> random_dir(vertical, horizontal);
+  check_area();
+  build(area, threads);
+}
+
+/**
+ * @brief   This method generates the maze with binary tree algorithm, straight into a bit-packed maze.
+ *          The rows share their words in a bit-packed maze, so it always runs on a single thread.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+void maze::binary_tree::generate(packed_grid &target)
+{
+  build(target, 1u);
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with binary tree algorithm.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::binary_tree::generate(uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate();
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with binary tree algorithm, straight into a bit-packed maze.
+ * @param   &target  - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::binary_tree::generate(packed_grid &target, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(target);
+}
+
+/**
+ * @brief   Sets how many threads generate() can use.
+ * @param   new_threads - Number of threads, 0 means every hardware thread. The default is 1.
+ * @return  void
+ */
+void maze::binary_tree::set_threads(uint32_t new_threads)
+{
+  threads = new_threads;
+}
+
+/**
+ * @brief   The actual generation, the same for every kind of maze storage.
+ * @param   &target       - The maze to generate into (grid or packed_grid).
+ * @param   thread_count  - Number of threads, 0 means every hardware thread.
+ * @return  void
+ */
+template <typename surface>
+void maze::binary_tree::build(surface &target, uint32_t thread_count)
+{
+  /* Every row has its own random stream, derived from the seed. */
+  /* This way the maze is the same, no matter which thread generates which row. */
+  uint32_t rows = target.get_height()/2u;
+  task_pool tasks(thread_count);
+
+  if (1u < tasks.get_threads())
+  {
+    uint32_t band = (rows+tasks.get_threads()-1u)/tasks.get_threads();
+    for (uint32_t first = 0u; first < rows; first += band)
+    {
+      uint32_t last = std::min(first+band, rows);
+      tasks.push([this, &target, first, last]() { carve_rows(target, seed, first, last); });
+    }
+    tasks.run();
+  }
+  else
+  {
+    carve_rows(target, seed, 0u, rows);
+  }
+}
+
+/**
+ * @brief   Creates the random stream of a row.
+ * @param   seed - Seed of the whole maze.
+ * @param   row  - Index of the row.
+ * @return  The random stream.
+ */
+maze::splitmix64 maze::binary_tree::row_stream(uint64_t seed, uint32_t row)
+{
+  splitmix64 row_seed(seed + row);
+  return splitmix64(row_seed());
+}
 
+/**
+ * @brief   Generates the rows of cells between first and last.
+ *          Every 64-bit random number gives the direction of 64 cells: 1 is vertical, 0 is horizontal.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @param   seed    - Seed of the whole maze.
+ * @param   first   - First row of cells.
+ * @param   last    - The row after the last one.
+ * @return  void
+ */
+template <typename surface>
+void maze::binary_tree::carve_rows(surface &target, uint64_t seed, uint32_t first, uint32_t last)
+{
+  uint32_t rows = target.get_height()/2u;
+  uint32_t columns = target.get_width()/2u;
   uint32_t orientation = none;
 
   /* Loop through vertically. */
-  for (uint32_t y = 1u; y < (area.size()-1u); y += 2)
+  for (uint32_t row = first; row < last; row++)
   {
+    splitmix64 random_generator = row_stream(seed, row);
+    uint64_t directions = 0u;
+    uint32_t y = row*2u+1u;
+
+    /* Start the row (and the row below it) from walls, so the passages of an earlier maze are not kept. */
+    /* The outer boundary, with the entrance and the exit, is left as it is. */
+    for (uint32_t x = 1u; x < (columns*2u); x++)
+    {
+      target(y, x) = wall;
+      if ((rows-1u) != row)
+      {
+        target(y+1u, x) = wall;
+      }
+    }
+
     /* Loop through horizontally. */
-    for (uint32_t x = 1u; x < (area[0u].size()-1u); x += 2)
+    for (uint32_t column = 0u; column < columns; column++)
     {
+      uint32_t x = column*2u+1u;
+
+      if (0u == (column%64u))
+      {
+        directions = random_generator();
+      }
+
       /* If we are at the end (vertically or horizontally), then we can only go to the other direction. */
       /* Or if we are the end in both cases, then skip the last step. */
-      if (((area[0u].size()-2u) == x) && ((area.size()-2u) == y))
+      if (((columns-1u) == column) && ((rows-1u) == row))
       {
         orientation = none;
       }
-      else if ((area[0u].size()-2u) == x)
+      else if ((columns-1u) == column)
       {
         orientation = horizontal;
       }
-      else if ((area.size()-2u) == y)
+      else if ((rows-1u) == row)
       {
         orientation = vertical;
       }      
-      /* If we aren't at the end, then randomly select a direction. */
+      /* If we aren't at the end, then use the next random bit. */
       else
       {
-        orientation = random_dir(random_generator); 
+        orientation = ((directions >> (column%64u)) & 1u) ? vertical : horizontal; 
       }
       
       if (vertical == orientation)
@@ -53,7 +176,7 @@ void maze::binary_tree::generate(void)
         /* Crave a passage 3 steps down. */
         for (uint32_t i = 0u; i < 3u; i++)
         {
-          area[y][x+i] = hole;
+          target(y, x+i) = hole;
         }
       }
       else if (horizontal == orientation)
@@ -61,14 +184,86 @@ void maze::binary_tree::generate(void)
         /* Crave a passage 3 steps left. */
         for (uint32_t i = 0u; i < 3u; i++)
         {
-          area[y+i][x] = hole;
+          target(y+i, x) = hole;
         }
       }
+      /* The last cell has nowhere to go, but it is still carved (it is only reached this way, if it is the only cell). */
       else
       {
-        /* Do nothing. */
+        target(y, x) = hole;
       }
     }
   }
 }
 
+/**
+ * @brief   Generates the rows of cells between first and last, the fast way for a grid.
+ *          The same as the generic version, but it writes the two rows of the grid directly,
+ *          without branches, so the compiler can vectorise the inner loop.
+ * @param   &target - The maze to generate into.
+ * @param   seed    - Seed of the whole maze.
+ * @param   first   - First row of cells.
+ * @param   last    - The row after the last one.
+ * @return  void
+ */
+void maze::binary_tree::carve_rows(grid &target, uint64_t seed, uint32_t first, uint32_t last)
+{
+  uint32_t rows = target.get_height()/2u;
+  uint32_t columns = target.get_width()/2u;
+
+  /* A maze, that is a single column of walls, has no cells to carve. */
+  if (0u == columns)
+  {
+    return;
+  }
+
+  for (uint32_t row = first; row < last; row++)
+  {
+    splitmix64 random_generator = row_stream(seed, row);
+    uint8_t *cells = &target(row*2u+1u, 0u);
+    uint8_t *below = &target(row*2u+2u, 0u);
+    bool last_row = ((rows-1u) == row);
+
+    /* Start from walls, like the generic version. The outer boundary is left as it is. */
+    std::fill(cells+1u, cells+columns*2u, static_cast<uint8_t>(wall));
+    if (!last_row)
+    {
+      std::fill(below+1u, below+columns*2u, static_cast<uint8_t>(wall));
+    }
+
+    /* Every cell, except the last one, in blocks of 64. */
+    for (uint32_t block = 0u; block < (columns-1u); block += 64u)
+    {
+      uint64_t directions = random_generator();
+      uint32_t count = std::min(64u, columns-1u-block);
+      uint8_t *cell = &cells[block*2u+1u];
+      uint8_t *cell_below = &below[block*2u+1u];
+
+      /* The last row can only go east. */
+      if (last_row)
+      {
+        directions = ~static_cast<uint64_t>(0u);
+      }
+
+      for (uint32_t i = 0u; i < count; i++)
+      {
+        uint8_t east_open = static_cast<uint8_t>((directions >> i) & 1u);
+        cell[i*2u] = hole;
+        cell[i*2u+1u] = static_cast<uint8_t>(east_open*hole);
+        cell[i*2u+2u] = hole;
+        if (!last_row)
+        {
+          cell_below[i*2u] = static_cast<uint8_t>((east_open ^ 1u)*hole);
+        }
+      }
+    }
+
+    /* The last cell can only go south, except in the last row. */
+    /* The only cell of a maze has nowhere to go, but it is carved, like in the generic version. */
+    cells[columns*2u-1u] = hole;
+    if (!last_row)
+    {
+      below[columns*2u-1u] = hole;
+    }
+  }
+}
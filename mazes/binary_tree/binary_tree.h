@@ -11,6 +11,8 @@
 #define BINARY_TREE_H_
 
 #include "maze_generator.h"
+#include "random.h"
+#include "task_pool.h"
 
 namespace maze
 {
@@ -19,9 +21,21 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(packed_grid &target);
+      void generate(uint64_t new_seed);
+      void generate(packed_grid &target, uint64_t new_seed);
+
+      void set_threads(uint32_t new_threads);
     
-    private:      
+    private:
       static constexpr uint32_t none = 2u; /**< Third option after vertical and horizontal. */
+
+      uint32_t threads = 1u;
+
+      template <typename surface> void build(surface &target, uint32_t thread_count);
+      template <typename surface> void carve_rows(surface &target, uint64_t seed, uint32_t first, uint32_t last);
+      void carve_rows(grid &target, uint64_t seed, uint32_t first, uint32_t last);
+      static splitmix64 row_stream(uint64_t seed, uint32_t row);
   };
 }
 
@@ -0,0 +1,291 @@
+/**
+ * @file    eller.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Streaming maze generator class with Eller's algorithm.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "eller.h"
+
+/**
+ * @brief   Constructor. Only saves the dimensions, the maze itself is never stored. The seed comes from the random device.
+ * @param   height - Height of the maze.
+ * @param   width  - Width of the maze.
+ * @return  void
+ */
+maze::eller::eller(uint64_t height, uint32_t width) : eller(height, width, maze_generator::random_seed())
+{
+}
+
+/**
+ * @brief   Constructor. Only saves the dimensions and the seed, the maze itself is never stored.
+ * @param   height - Height of the maze.
+ * @param   width  - Width of the maze.
+ * @param   seed   - Seed of the random generator. The same seed always gives the same maze.
+ * @return  void
+ */
+maze::eller::eller(uint64_t height, uint32_t width, uint64_t seed) : seed(seed), height(height), width(width)
+{
+  /* Make sure, that the dimensions are odd numbers, otherwise the maze would look strange. */
+  if ((!(height%2u)) || (!(width%2u)))
+  {
+    throw std::invalid_argument("Height and width must be odd numbers!");
+  }
+  /* At least one cell is needed. */
+  if ((3u > height) || (3u > width))
+  {
+    throw std::invalid_argument("Height and width must be at least 3!");
+  }
+}
+
+/**
+ * @brief   Places a hole into the first row.
+ * @param   x - The x coordinate of the hole (odd number).
+ * @return  void
+ */
+void maze::eller::set_entrance(uint32_t x)
+{
+  if ((width <= x) || (!(x%2u)))
+  {
+    throw std::invalid_argument("The entrance must be above a cell!");
+  }
+  entrance = x;
+}
+
+/**
+ * @brief   Places a hole into the last row.
+ * @param   x - The x coordinate of the hole (odd number).
+ * @return  void
+ */
+void maze::eller::set_exit(uint32_t x)
+{
+  if ((width <= x) || (!(x%2u)))
+  {
+    throw std::invalid_argument("The exit must be below a cell!");
+  }
+  exit = x;
+}
+
+/**
+ * @brief   This method generates the maze with Eller's algorithm, one row at a time.
+ *          Only O(width) memory is used, no matter how high the maze is.
+ * @param   &sink - Receives every row of the maze (height of them), from the top.
+ * @return  void
+ */
+void maze::eller::generate(const row_sink &sink)
+{
+  uint32_t columns = width/2u;
+  uint64_t rows = height/2u;
+  std::vector<uint8_t> row(width, static_cast<uint8_t>(wall));
+  std::vector<uint8_t> down(columns, 0u);
+  std::vector<uint8_t> set_goes_down(columns, 0u);
+  std::vector<uint32_t> set_size(columns, 0u);
+  std::vector<uint32_t> set_chosen(columns, 0u);
+  std::vector<uint32_t> free_sets;
+  free_sets.reserve(columns);
+
+  /* Mersenne Twister 19937 pseudo-random generator. */
+  random_generator = seeded<std::mt19937>(seed);
+  random_bits_left = 0u;
+
+  /* The north boundary. */
+  if (entrance)
+  {
+    row[entrance] = hole;
+  }
+  sink(row.data(), width);
+
+  /* Every cell of the first row is in its own set. */
+  sets.resize(columns);
+  parent.resize(columns);
+  for (uint32_t column = 0u; column < columns; column++)
+  {
+    sets[column] = column;
+  }
+
+  for (uint64_t row_index = 0u; row_index < rows; row_index++)
+  {
+    bool last_row = ((rows-1u) == row_index);
+
+    /* The sets can only be merged within the row. */
+    for (uint32_t set = 0u; set < columns; set++)
+    {
+      parent[set] = set;
+    }
+
+    /* Randomly join the neighbours, that are in different sets. In the last row, join every one of them. */
+    /* The decisions are random, so they are made without branches. */
+    std::fill(row.begin(), row.end(), static_cast<uint8_t>(wall));
+    uint32_t set = find(sets[0u]);
+    row[1u] = hole;
+    for (uint32_t column = 1u; column < columns; column++)
+    {
+      uint32_t set_west = set;
+      set = find(sets[column]);
+      bool join = (set != set_west) & (last_row | coin());
+      parent[set] = join ? set_west : set;
+      set = join ? set_west : set;
+      row[column*2u] = join ? static_cast<uint8_t>(hole) : static_cast<uint8_t>(wall);
+      row[column*2u+1u] = hole;
+    }
+    for (uint32_t column = 0u; column < columns; column++)
+    {
+      sets[column] = find(sets[column]);
+    }
+    sink(row.data(), width);
+
+    /* The row of the passages downwards. */
+    std::fill(row.begin(), row.end(), static_cast<uint8_t>(wall));
+    if (last_row)
+    {
+      if (exit)
+      {
+        row[exit] = hole;
+      }
+      sink(row.data(), width);
+      break;
+    }
+
+    /* Randomly go down. Also pick a random cell of every set, in case none of its cells go down. */
+    for (uint32_t column = 0u; column < columns; column++)
+    {
+      set_size[sets[column]] = 0u;
+      set_goes_down[sets[column]] = 0u;
+    }
+    for (uint32_t column = 0u; column < columns; column++)
+    {
+      uint32_t set = sets[column];
+      set_size[set]++;
+      /* The n-th cell of the set is chosen with 1/n probability, so every cell has the same chance at the end. */
+      if ((1u == set_size[set]) || (0u == ((static_cast<uint64_t>(random_generator())*set_size[set]) >> 32u)))
+      {
+        set_chosen[set] = column;
+      }
+      down[column] = coin() ? 1u : 0u;
+      set_goes_down[set] |= down[column];
+    }
+    /* Every set must go down at least once, otherwise it would be cut off. */
+    for (uint32_t column = 0u; column < columns; column++)
+    {
+      if ((!set_goes_down[sets[column]]) && (set_chosen[sets[column]] == column))
+      {
+        down[column] = 1u;
+      }
+    }
+
+    /* The cells below a passage stay in the same set, the others get a set, that isn't used. */
+    std::fill(set_goes_down.begin(), set_goes_down.end(), 0u);
+    for (uint32_t column = 0u; column < columns; column++)
+    {
+      if (down[column])
+      {
+        set_goes_down[sets[column]] = 1u;
+        row[column*2u+1u] = hole;
+      }
+    }
+    free_sets.clear();
+    for (uint32_t set = 0u; set < columns; set++)
+    {
+      if (!set_goes_down[set])
+      {
+        free_sets.push_back(set);
+      }
+    }
+    for (uint32_t column = 0u; column < columns; column++)
+    {
+      if (!down[column])
+      {
+        sets[column] = free_sets.back();
+        free_sets.pop_back();
+      }
+    }
+    sink(row.data(), width);
+  }
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Eller's algorithm.
+ * @param   &sink    - Receives every row of the maze (height of them), from the top.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::eller::generate(const row_sink &sink, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(sink);
+}
+
+/**
+ * @brief   Changes the seed of the next generation.
+ * @param   new_seed - The new seed. The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::eller::set_seed(uint64_t new_seed)
+{
+  seed = new_seed;
+}
+
+/**
+ * @brief   Returns the seed, so a maze can be reproduced later.
+ * @param   void
+ * @return  seed
+ */
+uint64_t maze::eller::get_seed(void)
+{
+  return seed;
+}
+
+/**
+ * @brief   Returns the height of the maze.
+ * @param   void
+ * @return  height
+ */
+uint64_t maze::eller::get_height(void)
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the maze.
+ * @param   void
+ * @return  width
+ */
+uint32_t maze::eller::get_width(void)
+{
+  return width;
+}
+
+/**
+ * @brief   Returns a random bit. One random number gives 32 of them.
+ * @param   void
+ * @return  true or false
+ */
+bool maze::eller::coin(void)
+{
+  if (0u == random_bits_left)
+  {
+    random_bits = random_generator();
+    random_bits_left = 32u;
+  }
+  random_bits_left--;
+  bool bit = random_bits & 1u;
+  random_bits >>= 1u;
+  return bit;
+}
+
+/**
+ * @brief   Finds the set, that represents the input one (path halving).
+ * @param   set - The set.
+ * @return  The representative set.
+ */
+uint32_t maze::eller::find(uint32_t set)
+{
+  while (parent[set] != set)
+  {
+    parent[set] = parent[parent[set]];
+    set = parent[set];
+  }
+  return set;
+}
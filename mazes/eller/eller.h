@@ -0,0 +1,61 @@
+/**
+ * @file    eller.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Streaming maze generator class with Eller's algorithm.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef ELLER_H_
+#define ELLER_H_
+
+#include "maze_generator.h"
+
+namespace maze
+{
+  /**
+   * Unlike the other generators, it never stores the whole maze, only the current row.
+   * Every finished row goes straight to a sink, so the height of the maze is only limited by the sink.
+   */
+  class eller
+  {
+    public:
+      explicit eller(uint64_t height, uint32_t width);
+      explicit eller(uint64_t height, uint32_t width, uint64_t seed);
+
+      void set_entrance(uint32_t x);
+      void set_exit(uint32_t x);
+
+      void generate(const row_sink &sink);
+      void generate(const row_sink &sink, uint64_t new_seed);
+
+      void set_seed(uint64_t new_seed);
+      uint64_t get_seed(void);
+
+      uint64_t get_height(void);
+      uint32_t get_width(void);
+
+    private:
+      static constexpr uint8_t wall = maze_generator::wall;
+      static constexpr uint8_t hole = maze_generator::hole;
+
+      uint64_t seed; /**< The maze only depends on the dimensions and this. */
+      std::mt19937 random_generator;
+      uint32_t random_bits = 0u;
+      uint32_t random_bits_left = 0u;
+
+      uint64_t height;
+      uint32_t width;
+      uint32_t entrance = 0u;   /**< Hole in the first row, 0 means none. */
+      uint32_t exit = 0u;       /**< Hole in the last row, 0 means none. */
+
+      std::vector<uint32_t> sets;   /**< The set of every cell in the current row. */
+      std::vector<uint32_t> parent; /**< Disjoint-set forest of the sets, only within the current row. */
+
+      bool coin(void);
+      uint32_t find(uint32_t set);
+  };
+}
+
+#endif /* ELLER_H_ */
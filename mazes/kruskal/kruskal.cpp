@@ -16,69 +16,148 @@
  */
 void maze::kruskal::generate(void)
 {
-  /* Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
+  check_area();
+  build<std::mt19937>(area);
+}
+
+/**
+ * @brief   This method generates the maze with Kruskal's algorithm, straight into a bit-packed maze.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+void maze::kruskal::generate(packed_grid &target)
+{
+  build<std::mt19937>(target);
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Kruskal's algorithm.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::kruskal::generate(uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate();
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Kruskal's algorithm, straight into a bit-packed maze.
+ * @param   &target  - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::kruskal::generate(packed_grid &target, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(target);
+}
+
+/**
+ * @brief   This method generates the maze with Kruskal's algorithm, using the selected pseudo-random generator.
+ * @param   void
+ * @return  void
+ */
+template <typename engine>
+void maze::kruskal::generate(void)
+{
+  check_area();
+  build<engine>(area);
+}
 
-  /* Do the initialization for sets, similar way to area. */
-  sets.resize(area.size());
-  for (uint32_t y = 0u; y < area.size(); y++)
+/**
+ * @brief   This method generates the maze with Kruskal's algorithm, straight into a bit-packed maze, using the selected pseudo-random generator.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+template <typename engine>
+void maze::kruskal::generate(packed_grid &target)
+{
+  build<engine>(target);
+}
+
+/**
+ * @brief   The actual generation, the same for every kind of maze storage.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @return  void
+ */
+template <typename engine, typename surface>
+void maze::kruskal::build(surface &target)
+{
+  /* Pseudo-random generator, Mersenne Twister 19937 by default. */
+  engine random_generator = seeded<engine>(seed);
+
+  uint32_t rows = target.get_height()/2u;
+  uint32_t columns = target.get_width()/2u;
+  uint64_t cells = static_cast<uint64_t>(rows)*columns;
+
+  /* Every passage is stored as cell*2+orientation, so it has to fit into 32 bits. */
+  if ((cells*2u) > UINT32_MAX)
+  {
+    throw std::invalid_argument("The maze is too big for Kruskal's algorithm.");
+  }
+
+  /* Every cell starts in its own set. */
+  sets.resize(cells);
+  ranks.assign(cells, 0u);
+  for (uint32_t i = 0u; i < cells; i++)
   {
-    sets[y].resize(area[y].size());
+    sets[i] = i;
   }
 
-  /* Save every y,x coordinate with a possible movement (vertical or horizontal). */
-  /* Also, fill the sets with different values. */  
-  std::vector<element> elements;
-  uint32_t i = 1u;
-  for (uint32_t y = 1u; y < (sets.size()-1u); y+=2u)
+  /* Save every cell with a possible movement (vertical or horizontal). */
+  std::vector<uint32_t> edges;
+  edges.reserve(cells*2u);
+  for (uint32_t row = 0u; row < rows; row++)
   {
-    for (uint32_t x = 1u; x < (sets[0u].size()-1u); x+=2u)
+    for (uint32_t column = 0u; column < columns; column++)
     {
-      if ((y+2u) < (sets.size()-1u))
+      uint32_t cell = row*columns + column;
+      if ((row+1u) < rows)
       {
-        elements.push_back({y, x, vertical});
+        edges.push_back((cell << 1u) | vertical);
       }
-      if ((x+2u) < (sets[0u].size()-1u))
+      if ((column+1u) < columns)
       {
-        elements.push_back({y, x, horizontal});
+        edges.push_back((cell << 1u) | horizontal);
       }
-      sets[y][x] = i;
-      i++;
     }
   }
 
-  /* Shuffle the elements vector. */
-  std::shuffle(elements.begin(), elements.end(), random_generator);
+  /* Shuffle the edges vector (Fisher-Yates). */
+  for (uint32_t i = static_cast<uint32_t>(edges.size()); i > 1u; i--)
+  {
+    std::swap(edges[i-1u], edges[bounded(random_generator, i)]);
+  }
 
-  /* Do it until there are no elements left. */
-  while(elements.size())
+  /* Do it until there are no edges left. */
+  while(edges.size())
   {
-    uint32_t y = elements[elements.size()-1u].y;
-    uint32_t x = elements[elements.size()-1u].x;
-    uint32_t orientation = elements[elements.size()-1u].orientation;
-    elements.pop_back();    
+    uint32_t cell = edges[edges.size()-1u] >> 1u;
+    uint32_t orientation = edges[edges.size()-1u] & 1u;
+    uint32_t y = (cell/columns)*2u+1u;
+    uint32_t x = (cell%columns)*2u+1u;
+    edges.pop_back();
 
     if (horizontal == orientation)
     {
       /* If the two sets are different, then make them the same and crave a passage. */
-      if (sets[y][x+2u] != sets[y][x])
+      if (unite(cell, cell+1u))
       {
-        replace(sets[y][x+2u], sets[y][x]);
         for (uint32_t j = 0u; j < 3u; j++)
         {
-          area[y][x+j] = hole;
+          target(y, x+j) = hole;
         }
       }
     }
     else if (vertical == orientation)
     {
       /* If the two sets are different, then make them the same and crave a passage. */
-      if (sets[y+2u][x] != sets[y][x])
+      if (unite(cell, cell+columns))
       {
-        replace(sets[y+2u][x], sets[y][x]);
         for (uint32_t j = 0u; j < 3u; j++)
         {
-          area[y+j][x] = hole;
+          target(y+j, x) = hole;
         }
       }
     }
@@ -87,25 +166,61 @@ void maze::kruskal::generate(void)
       /* Do nothing. */
     }
   }
+
+  /* The sets aren't needed anymore. */
+  std::vector<uint32_t>().swap(sets);
+  std::vector<uint8_t>().swap(ranks);
 }
 
 /**
- * @brief   Loops through the sets array and replaces the chosen elements.
- * @param   set_to replace - The type of set, that needs to replaced.
- * @param   sample_set     - The new value, that's going to overwrite the others.
- * @return  void
+ * @brief   Finds the set of a cell. Every visited cell is pointed closer to the top (path halving).
+ * @param   cell - Index of the cell.
+ * @return  The cell, that represents the whole set.
  */
-void maze::kruskal::replace(uint32_t set_to_replace, uint32_t sample_set)
+uint32_t maze::kruskal::find(uint32_t cell)
 {
-  for (uint32_t search_y = 1u; search_y < (sets.size()-1u); search_y+=2u)
+  while (sets[cell] != cell)
   {
-    for (uint32_t search_x = 1u; search_x < (sets[0u].size()-1u); search_x+=2u)
-    {
-      if (sets[search_y][search_x] == set_to_replace)
-      {
-        sets[search_y][search_x] = sample_set;
-      }
-    }
+    sets[cell] = sets[sets[cell]];
+    cell = sets[cell];
+  }
+  return cell;
+}
+
+/**
+ * @brief   Merges the sets of two cells. The lower tree goes under the higher one (union by rank).
+ * @param   first  - Index of the first cell.
+ * @param   second - Index of the second cell.
+ * @return  True if they were in different sets, false if they were already in the same one.
+ */
+bool maze::kruskal::unite(uint32_t first, uint32_t second)
+{
+  first = find(first);
+  second = find(second);
+
+  if (first == second)
+  {
+    return false;
+  }
+
+  if (ranks[first] < ranks[second])
+  {
+    std::swap(first, second);
+  }
+  sets[second] = first;
+  if (ranks[first] == ranks[second])
+  {
+    ranks[first]++;
   }
+  return true;
 }
 
+/* Every pseudo-random generator, that can be selected. */
+template void maze::kruskal::generate<std::mt19937>(void);
+template void maze::kruskal::generate<maze::xoshiro256starstar>(void);
+template void maze::kruskal::generate<maze::pcg32>(void);
+template void maze::kruskal::generate<maze::splitmix64>(void);
+template void maze::kruskal::generate<std::mt19937>(packed_grid &target);
+template void maze::kruskal::generate<maze::xoshiro256starstar>(packed_grid &target);
+template void maze::kruskal::generate<maze::pcg32>(packed_grid &target);
+template void maze::kruskal::generate<maze::splitmix64>(packed_grid &target);
@@ -19,17 +19,19 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(packed_grid &target);
+      void generate(uint64_t new_seed);
+      void generate(packed_grid &target, uint64_t new_seed);
+      template <typename engine> void generate(void);
+      template <typename engine> void generate(packed_grid &target);
 
     private:
-      struct element {
-        uint32_t y;
-        uint32_t x;
-        uint32_t orientation;
-      };
+      std::vector<uint32_t> sets;   /**< Disjoint-set forest, one parent for every cell. */
+      std::vector<uint8_t> ranks;   /**< Upper bound of the height of every tree. */
 
-      std::vector<std::vector<uint32_t>> sets;
-
-      void replace(uint32_t set_to_replace, uint32_t sample_set);
+      template <typename engine, typename surface> void build(surface &target);
+      uint32_t find(uint32_t cell);
+      bool unite(uint32_t first, uint32_t second);
   };
 }
 
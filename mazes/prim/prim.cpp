@@ -16,111 +16,188 @@
  */
 void maze::prim::generate(void)
 {
-  /* Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
-  /* Random starting point. */
-  std::uniform_int_distribution<uint32_t> random_start_y(1u, area.size()-2u);
-  std::uniform_int_distribution<uint32_t> random_start_x(1u, area[0u].size()-2u);
-  /* Random direction. */
-  std::uniform_int_distribution<uint32_t> random_dir(north, east);
+  check_area();
+  build<std::mt19937>(area);
+}
+
+/**
+ * @brief   This method generates the maze with Prim's algorithm, straight into a bit-packed maze.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+void maze::prim::generate(packed_grid &target)
+{
+  build<std::mt19937>(target);
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Prim's algorithm.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::prim::generate(uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate();
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with Prim's algorithm, straight into a bit-packed maze.
+ * @param   &target  - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::prim::generate(packed_grid &target, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(target);
+}
+
+/**
+ * @brief   This method generates the maze with Prim's algorithm, using the selected pseudo-random generator.
+ * @param   void
+ * @return  void
+ */
+template <typename engine>
+void maze::prim::generate(void)
+{
+  check_area();
+  build<engine>(area);
+}
+
+/**
+ * @brief   This method generates the maze with Prim's algorithm, straight into a bit-packed maze, using the selected pseudo-random generator.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+template <typename engine>
+void maze::prim::generate(packed_grid &target)
+{
+  build<engine>(target);
+}
+
+/**
+ * @brief   The actual generation, the same for every kind of maze storage.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @return  void
+ */
+template <typename engine, typename surface>
+void maze::prim::build(surface &target)
+{
+  /* Pseudo-random generator, Mersenne Twister 19937 by default. */
+  engine random_generator = seeded<engine>(seed);
+
+  /* One bit for every cell, set when the cell becomes a frontier. */
+  in_frontier.assign(static_cast<size_t>(target.get_height()/2u)*(target.get_width()/2u), false);
+  frontiers.clear();
 
-  /* Make sure, that the two random numbers are odd. */
-  mark(random_start_y(random_generator)/2u*2u+1u, random_start_x(random_generator)/2u*2u+1u);
+  /* Random starting cell, its coordinates are odd numbers. */
+  uint32_t start_y = bounded(random_generator, target.get_height()/2u)*2u+1u;
+  uint32_t start_x = bounded(random_generator, target.get_width()/2u)*2u+1u;
+  mark(target, start_y, start_x);
 
   /* Loop until there are no frontiers left. */
   while(!frontiers.empty())
   {
-    bool possible_to_crave = false;
-
     /* Randomly select a frontier from the list.*/
-    std::uniform_int_distribution<uint32_t> random_frontier(0u, frontiers.size()-1u);
-    uint32_t next_frontier = random_frontier(random_generator);
+    uint32_t next_frontier = bounded(random_generator, static_cast<uint32_t>(frontiers.size()));
     uint32_t y = frontiers[next_frontier].y;
     uint32_t x = frontiers[next_frontier].x;
-    /* Remove frontier from the list. */
-    frontiers.erase(frontiers.begin()+next_frontier);
+    /* Remove frontier from the list. The last one takes its place, so nothing has to be moved. */
+    frontiers[next_frontier] = frontiers.back();
+    frontiers.pop_back();
+
+    /* Collect the directions, where the neighbour is already a hole. There is at least one. */
+    uint8_t directions[4u];
+    uint32_t count = 0u;
+    if ((y > 2u) && (hole == target(y-2u, x)))
+    {
+      directions[count++] = north;
+    }
+    if (((y+2u) < (target.get_height()-1u)) && (hole == target(y+2u, x)))
+    {
+      directions[count++] = south;
+    }
+    if ((x > 2u) && (hole == target(y, x-2u)))
+    {
+      directions[count++] = west;
+    }
+    if (((x+2u) < (target.get_width()-1u)) && (hole == target(y, x+2u)))
+    {
+      directions[count++] = east;
+    }
 
-    /* Try to move to one direction (loop until we find a possible way to go). */
-    while(!possible_to_crave)
+    /* Randomly select one of them and crave a hole towards it. */
+    uint8_t direction = directions[(1u < count) ? bounded(random_generator, count) : 0u];
+    if (north == direction)
     {
-      uint32_t direction = random_dir(random_generator);
-      if (north == direction)
-      {
-        /* If it is possible to go north, then crave a hole and stop the loop. */
-        if ((y > 2u) && (hole == area[y-2u][x]))
-        {
-          possible_to_crave = true;
-          area[y-1u][x] = hole;
-        }
-      }
-      else if (south == direction)
-      {
-        /* If it is possible to go south, then crave a hole and stop the loop. */
-        if (((y+2u) < (area.size()-1u)) && (hole == area[y+2u][x]))
-        {
-          possible_to_crave = true;
-          area[y+1u][x] = hole;
-        }
-      }
-      else if (west == direction)
-      {
-        /* If it is possible to go west, then crave a hole and stop the loop. */
-        if ((x > 2u) && (hole == area[y][x-2]))
-        {
-          possible_to_crave = true;
-          area[y][x-1u] = hole;
-        }
-      }
-      else if (east == direction)
-      {
-        /* If it is possible to go east, then crave a hole and stop the loop. */
-        if (((x+2u) < (area[0u].size()-1u)) && (hole == area[y][x+2u]))
-        {
-          possible_to_crave = true;
-          area[y][x+1u] = hole;
-        }
-      }
+      target(y-1u, x) = hole;
+    }
+    else if (south == direction)
+    {
+      target(y+1u, x) = hole;
+    }
+    else if (west == direction)
+    {
+      target(y, x-1u) = hole;
+    }
+    else
+    {
+      target(y, x+1u) = hole;
     }
 
     /* Create new frontiers. */
-    mark(y, x);
-    
+    mark(target, y, x);
   }
 }
 
 /**
  * @brief   Set a hole at [y,x] coordinate and mark every possible neighboor cell as frontier.
- * @param   y - Coordinate of the new hole.
- *          x - Coordinate of the new hole.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @param   y       - Coordinate of the new hole.
+ *          x       - Coordinate of the new hole.
  * @return  void
  */
-void maze::prim::mark(uint32_t y, uint32_t x)
+template <typename surface>
+void maze::prim::mark(surface &target, uint32_t y, uint32_t x)
 {
+  size_t cells_per_row = target.get_width()/2u;
+  size_t cell = (y/2u)*cells_per_row + (x/2u);
+
   /* Mark as a hole. */
-  area[y][x] = hole;
+  target(y, x) = hole;
   /* Save the cell at north as a frontier (if it isn't out of boundary). */
-  if ((y >= 3u) && (wall == area[y-2u][x]))
+  if ((y >= 3u) && (wall == target(y-2u, x)) && (!in_frontier[cell-cells_per_row]))
   {
-    area[y-2u][x] = frontier;
+    in_frontier[cell-cells_per_row] = true;
     frontiers.push_back({y-2u,x});
   }
   /* Save the cell at south as a frontier (if it isn't out of boundary). */
-  if (((y+2u) <= area.size()-2u) && (wall == area[y+2u][x]))
+  if (((y+2u) <= target.get_height()-2u) && (wall == target(y+2u, x)) && (!in_frontier[cell+cells_per_row]))
   {
-    area[y+2u][x] = frontier;
+    in_frontier[cell+cells_per_row] = true;
     frontiers.push_back({y+2u,x});
   }
   /* Save the cell at west as a frontier (if it isn't out of boundary). */
-  if ((x >= 3u) && (wall == area[y][x-2u]))
+  if ((x >= 3u) && (wall == target(y, x-2u)) && (!in_frontier[cell-1u]))
   {
-    area[y][x-2u] = frontier;
+    in_frontier[cell-1u] = true;
     frontiers.push_back({y,x-2u});
   }
   /* Save the cell at east as a frontier (if it isn't out of boundary). */
-  if (((x+2u) <= area[0u].size()-2u) && (wall == area[y][x+2u]))
+  if (((x+2u) <= target.get_width()-2u) && (wall == target(y, x+2u)) && (!in_frontier[cell+1u]))
   {
-    area[y][x+2u] = frontier;
+    in_frontier[cell+1u] = true;
     frontiers.push_back({y,x+2u});
   }
 }
 
+/* Every pseudo-random generator, that can be selected. */
+template void maze::prim::generate<std::mt19937>(void);
+template void maze::prim::generate<maze::xoshiro256starstar>(void);
+template void maze::prim::generate<maze::pcg32>(void);
+template void maze::prim::generate<maze::splitmix64>(void);
+template void maze::prim::generate<std::mt19937>(packed_grid &target);
+template void maze::prim::generate<maze::xoshiro256starstar>(packed_grid &target);
+template void maze::prim::generate<maze::pcg32>(packed_grid &target);
+template void maze::prim::generate<maze::splitmix64>(packed_grid &target);
@@ -19,18 +19,23 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(packed_grid &target);
+      void generate(uint64_t new_seed);
+      void generate(packed_grid &target, uint64_t new_seed);
+      template <typename engine> void generate(void);
+      template <typename engine> void generate(packed_grid &target);
 
-    private:      
-      static constexpr uint32_t frontier = 2u; /**< Third option after wall and hole. */
-
+    private:
       struct frontier_location {
               uint32_t y;
               uint32_t x;
       };
 
       std::vector<frontier_location> frontiers;
+      std::vector<bool> in_frontier; /**< One bit per cell, so the frontiers aren't stored in the maze itself. */
 
-      void mark(uint32_t y, uint32_t x);
+      template <typename engine, typename surface> void build(surface &target);
+      template <typename surface> void mark(surface &target, uint32_t y, uint32_t x);
   };
 }
 
@@ -16,86 +16,188 @@
  */
 void maze::recursive_backtracking::generate(void)
 {
-  /* Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
-  /* Random starting point. */
-  std::uniform_int_distribution<uint32_t> random_start_y(1u, area.size()-2u);
-  std::uniform_int_distribution<uint32_t> random_start_x(1u, area[0u].size()-2u);
+  check_area();
+  build<std::mt19937>(area);
+}
+
+/**
+ * @brief   This method generates the maze with recursive backtracking algorithm, straight into a bit-packed maze.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+void maze::recursive_backtracking::generate(packed_grid &target)
+{
+  build<std::mt19937>(target);
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with recursive backtracking algorithm.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::recursive_backtracking::generate(uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate();
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with recursive backtracking algorithm, straight into a bit-packed maze.
+ * @param   &target  - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::recursive_backtracking::generate(packed_grid &target, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(target);
+}
+
+/**
+ * @brief   This method generates the maze with recursive backtracking algorithm, using the selected pseudo-random generator.
+ * @param   void
+ * @return  void
+ */
+template <typename engine>
+void maze::recursive_backtracking::generate(void)
+{
+  check_area();
+  build<engine>(area);
+}
+
+/**
+ * @brief   This method generates the maze with recursive backtracking algorithm, straight into a bit-packed maze, using the selected pseudo-random generator.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+template <typename engine>
+void maze::recursive_backtracking::generate(packed_grid &target)
+{
+  build<engine>(target);
+}
+
+/**
+ * @brief   The actual generation, the same for every kind of maze storage.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @return  void
+ */
+template <typename engine, typename surface>
+void maze::recursive_backtracking::build(surface &target)
+{
+  /* Pseudo-random generator, Mersenne Twister 19937 by default. */
+  engine random_generator = seeded<engine>(seed);
+  /* Random starting cell, its coordinates are odd numbers. */
+  uint32_t start_y = bounded(random_generator, target.get_height()/2u)*2u+1u;
+  uint32_t start_x = bounded(random_generator, target.get_width()/2u)*2u+1u;
 
   /* Start the craving process. */
-  /* Make sure, that the two random numbers are odd. */
-  crave_passage(random_start_y(random_generator)/2u*2u+1u, random_start_x(random_generator)/2u*2u+1u);
+  crave_passage(target, random_generator, start_y, start_x);
 }
 
 /**
  * @brief   Randomly craves (creates holes) through the maze.
- * @param   void
+ *          It isn't recursive anymore: the way back is stored on an explicit stack, 2 bits per step,
+ *          so the size of the maze isn't limited by the size of the thread stack.
+ * @param   &target           - The maze to generate into (grid or packed_grid).
+ * @param   &random_generator - The pseudo-random generator of this generation.
+ * @param   y                 - Coordinate of the starting cell.
+ *          x                 - Coordinate of the starting cell.
  * @return  void
  */
-void maze::recursive_backtracking::crave_passage(uint32_t y, uint32_t x)
+template <typename surface, typename engine>
+void maze::recursive_backtracking::crave_passage(surface &target, engine &random_generator, uint32_t y, uint32_t x)
 {
-  /* The 4 directions, we can go. */
-  std::vector<uint32_t> directions = {north, south, west, east};
-  
-  /* Randomly shuffle the directions. */
-  std::mt19937 random_generator(random_device());
-  std::shuffle(directions.begin(), directions.end(), random_generator);
-
-  /* Go through each direction inside the randomly filled vector. */
-  for (uint32_t i = 0u; i < directions.size(); i++)
+  uint64_t columns = target.get_width()/2u;
+  uint64_t cells = (target.get_height()/2u)*columns;
+  uint64_t cell = (y/2u)*columns + (x/2u);
+
+  /* One bit for every cell, that has been visited. */
+  std::vector<uint64_t> visited((cells+63u)/64u, 0u);
+  /* The direction back to the previous cell, 32 steps in every word. */
+  std::vector<uint64_t> way_back((cells+31u)/32u, 0u);
+  uint64_t depth = 0u;
+
+  target(y, x) = hole;
+  visited[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
+
+  while (true)
   {
-    if (north == directions[i])
+    /* Collect the directions, where the neighbour hasn't been visited yet. */
+    uint8_t directions[4u];
+    uint32_t count = 0u;
+    if ((y > 2u) && (!((visited[(cell-columns)/64u] >> ((cell-columns)%64u)) & 1u)))
+    {
+      directions[count++] = north;
+    }
+    if (((y+2u) < (target.get_height()-1u)) && (!((visited[(cell+columns)/64u] >> ((cell+columns)%64u)) & 1u)))
+    {
+      directions[count++] = south;
+    }
+    if ((x > 2u) && (!((visited[(cell-1u)/64u] >> ((cell-1u)%64u)) & 1u)))
+    {
+      directions[count++] = west;
+    }
+    if (((x+2u) < (target.get_width()-1u)) && (!((visited[(cell+1u)/64u] >> ((cell+1u)%64u)) & 1u)))
+    {
+      directions[count++] = east;
+    }
+
+    uint8_t direction = 0u;
+    if (count)
+    {
+      /* Randomly select one of them, crave a passage and save the way back (the opposite direction). */
+      direction = directions[(1u < count) ? bounded(random_generator, count) : 0u];
+      way_back[depth/32u] &= ~(static_cast<uint64_t>(3u) << ((depth%32u)*2u));
+      way_back[depth/32u] |= static_cast<uint64_t>(direction ^ 1u) << ((depth%32u)*2u);
+      depth++;
+    }
+    else if (depth)
     {
-      /* If it is possible to go north, then crave a passage and call the function again. */
-      if ((y > 2u) && (wall == area[y-2u][x]))
-      {
-        for (uint32_t j = 0u; j < 3u; j++)
-        {
-          area[y-2u+j][x] = hole;
-        }
-        crave_passage(y-2u, x);
-      }
+      /* Dead-end, step back to the previous cell. */
+      depth--;
+      direction = (way_back[depth/32u] >> ((depth%32u)*2u)) & 3u;
     }
-    else if (south == directions[i])
+    else
+    {
+      /* Back at the start, every cell has been visited. */
+      break;
+    }
+
+    if (north == direction)
     {
-      /* If it is possible to go south, then crave a passage and call the function again. */
-      if (((y+2u) < (area.size()-1u)) && (wall == area[y+2u][x]))
-      {
-        for (uint32_t j = 0u; j < 3u; j++)
-        {
-          area[y+j][x] = hole;
-        }
-        crave_passage(y+2u, x);
-      }
+      target(y-1u, x) = hole;
+      y -= 2u;
+      cell -= columns;
     }
-    else if (west == directions[i])
+    else if (south == direction)
     {
-      /* If it is possible to go west, then crave a passage and call the function again. */
-      if ((x > 2u) && (wall == area[y][x-2]))
-      {
-        for (uint32_t j = 0u; j < 3u; j++)
-        {
-          area[y][x-2u+j] = hole;
-        }
-        crave_passage(y, x-2u);
-      }
+      target(y+1u, x) = hole;
+      y += 2u;
+      cell += columns;
     }
-    else if (east == directions[i])
+    else if (west == direction)
     {
-      /* If it is possible to go east, then crave a passage and call the function again. */
-      if (((x+2u) < (area[0u].size()-1u)) && (wall == area[y][x+2u]))
-      {
-        for (uint32_t j = 0u; j < 3u; j++)
-        {
-          area[y][x+j] = hole;
-        }
-        crave_passage(y, x+2u);
-      }
+      target(y, x-1u) = hole;
+      x -= 2u;
+      cell--;
     }
     else
     {
-      /* Do nothing. */
+      target(y, x+1u) = hole;
+      x += 2u;
+      cell++;
     }
+    target(y, x) = hole;
+    visited[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
   }
 }
 
+/* Every pseudo-random generator, that can be selected. */
+template void maze::recursive_backtracking::generate<std::mt19937>(void);
+template void maze::recursive_backtracking::generate<maze::xoshiro256starstar>(void);
+template void maze::recursive_backtracking::generate<maze::pcg32>(void);
+template void maze::recursive_backtracking::generate<maze::splitmix64>(void);
+template void maze::recursive_backtracking::generate<std::mt19937>(packed_grid &target);
+template void maze::recursive_backtracking::generate<maze::xoshiro256starstar>(packed_grid &target);
+template void maze::recursive_backtracking::generate<maze::pcg32>(packed_grid &target);
+template void maze::recursive_backtracking::generate<maze::splitmix64>(packed_grid &target);
@@ -19,9 +19,15 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(packed_grid &target);
+      void generate(uint64_t new_seed);
+      void generate(packed_grid &target, uint64_t new_seed);
+      template <typename engine> void generate(void);
+      template <typename engine> void generate(packed_grid &target);
 
     private:
-      void crave_passage(uint32_t y, uint32_t x);
+      template <typename engine, typename surface> void build(surface &target);
+      template <typename surface, typename engine> void crave_passage(surface &target, engine &random_generator, uint32_t y, uint32_t x);
   };
 }
 
@@ -11,37 +11,136 @@
 
 /**
  * @brief   This method generates the maze with recursive divsion algorithm.
+ *          It runs on as many threads, as set_threads() allows. The result only depends on the random seed.
  * @param   void
  * @return  void
  */
 void maze::recursive_division::generate(void)
 {
-  /* Overwrite the center with holes, so the area is going to be an empty place with wall boundaries. */
-  for (uint32_t y = 1u; y < (area.size()-1u); y++)
+  check_area();
+  build(area, threads);
+}
+
+/**
+ * @brief   This method generates the maze with recursive divsion algorithm, straight into a bit-packed maze.
+ *          The cells share their words in a bit-packed maze, so it always runs on a single thread.
+ * @param   &target - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @return  void
+ */
+void maze::recursive_division::generate(packed_grid &target)
+{
+  build(target, 1u);
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with recursive division algorithm.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::recursive_division::generate(uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate();
+}
+
+/**
+ * @brief   Sets the seed, then generates the maze with recursive division algorithm, straight into a bit-packed maze.
+ * @param   &target  - The maze to generate into. Entrance and exit can be set on it beforehand.
+ * @param   new_seed - The same seed always gives the same maze.
+ * @return  void
+ */
+void maze::recursive_division::generate(packed_grid &target, uint64_t new_seed)
+{
+  set_seed(new_seed);
+  generate(target);
+}
+
+/**
+ * @brief   Sets how many threads generate() can use.
+ * @param   new_threads - Number of threads, 0 means every hardware thread. The default is 1.
+ * @return  void
+ */
+void maze::recursive_division::set_threads(uint32_t new_threads)
+{
+  threads = new_threads;
+}
+
+/**
+ * @brief   The actual generation, the same for every kind of maze storage.
+ * @param   &target       - The maze to generate into (grid or packed_grid).
+ * @param   thread_count  - Number of threads, 0 means every hardware thread.
+ * @return  void
+ */
+template <typename surface>
+void maze::recursive_division::build(surface &target, uint32_t thread_count)
+{
+  /* Only the first division gets its stream from the seed, every other one is derived from it. */
+  task_pool tasks(thread_count);
+
+  if (1u < tasks.get_threads())
   {
-    for (uint32_t x = 1u; x < (area[0u].size()-1u); x++)
+    /* Every thread clears a band of rows, then the divisions are split between them. */
+    uint32_t band = (target.get_height()+tasks.get_threads()-1u)/tasks.get_threads();
+    for (uint32_t first = 1u; first < (target.get_height()-1u); first += band)
     {
-      area[y][x] = hole;
+      uint32_t last = std::min(first+band, target.get_height()-1u);
+      tasks.push([this, &target, first, last]() { clear(target, first, last); });
     }
+    tasks.run();
+
+    pool = &tasks;
+    tasks.push([this, &target]() { divide(target, seed, 0u, 0u, target.get_height(), target.get_width()); });
+    tasks.run();
+    pool = nullptr;
   }
+  else
+  {
+    clear(target, 1u, target.get_height()-1u);
+    divide(target, seed, 0u, 0u, target.get_height(), target.get_width());
+  }
+}
 
-  /* Start to divide the area. */
-  divide(0u, 0u, area.size(), area[0u].size());
+/**
+ * @brief   Overwrites the center with holes, so the area is going to be an empty place with wall boundaries.
+ *          The corners between the cells are skipped, every one of them ends up under a wall anyway.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @param   first   - First row to clear.
+ * @param   last    - The row after the last one to clear.
+ * @return  void
+ */
+template <typename surface>
+void maze::recursive_division::clear(surface &target, uint32_t first, uint32_t last)
+{
+  for (uint32_t y = first; y < last; y++)
+  {
+    for (uint32_t x = 1u; x < (target.get_width()-1u); x++)
+    {
+      if ((y & 1u) || (x & 1u))
+      {
+        target(y, x) = hole;
+      }
+    }
+  }
 }
 
 /**
  * @brief   Randomly places a wall across two borders.
  *          Randomly place a hole on the wall.
+ *          Every call has its own random stream, and the streams of the two halves are derived from it.
+ *          This way the maze is the same, no matter which thread runs which half.
+ * @param   &target - The maze to generate into (grid or packed_grid).
+ * @param   stream  - Seed of the random stream of this division.
  * @param   y       - Origin point (y) of where the wall and hole can be placed.
  *          x       - Origin point (x) of where the wall and hole can be placed.
  *          height  - End point (y) of where the wall and hole can be placed.
  *          width   - End point (x) of where the wall and hole can placed.
  * @return  vod
  */
-void maze::recursive_division::divide(uint32_t y, uint32_t x, uint32_t height, uint32_t width)
+template <typename surface>
+void maze::recursive_division::divide(surface &target, uint64_t stream, uint32_t y, uint32_t x, uint32_t height, uint32_t width)
 {  
-  /*  Mersenne Twister 19937 pseudo-random generator. */
-  std::mt19937 random_generator(random_device());
+  /* SplitMix64 pseudo-random generator, cheap to create for every division. */
+  splitmix64 random_generator(stream);
 
   uint32_t orientation = horizontal;
   uint32_t new_wall = 0u;
@@ -66,32 +165,29 @@ void maze::recursive_division::divide(uint32_t y, uint32_t x, uint32_t height, u
   }
   else
   {
-    std::uniform_int_distribution<uint32_t> random_dir(vertical, horizontal);
-    orientation = random_dir(random_generator);
+    orientation = vertical + bounded(random_generator, horizontal-vertical+1u);
   }
 
   if (horizontal == orientation)
   {
-    /* Not enough space, stop. */
-    if (height < 5u)
+    /* Not enough space for the wall or for the hole in it, stop. */
+    if ((height < 5u) || (width < 3u))
     {
       return;
     }
 
-    /* Random place for the wall and for the hole. */
-    std::uniform_int_distribution<uint32_t> random_wall(2u, height-3u);
-    std::uniform_int_distribution<uint32_t> random_hole(1u, width-2u);
+    /* Random place for the wall (2 ... height-3) and for the hole (1 ... width-2). */
     /* Make sure, that the wall is on an even coordinate and the hole is on an odd coordinate. */
-    new_wall = y + (random_wall(random_generator)/2u*2u);
-    new_hole = x + (random_hole(random_generator)/2u*2u+1u);
+    new_wall = y + ((bounded(random_generator, height-4u)+2u)/2u*2u);
+    new_hole = x + ((bounded(random_generator, width-2u)+1u)/2u*2u+1u);
 
     /* Place the wall. */
     for (uint32_t i = x; i < (x+width-1u); i++)
     {
-      area[new_wall][i] = wall;
+      target(new_wall, i) = wall;
     }
     /* Place the hole. */
-    area[new_wall][new_hole] = hole;
+    target(new_wall, new_hole) = hole;
     
     /* Calculate the new values for the next run. */
     new_height = new_wall-y+1u;
@@ -104,26 +200,24 @@ void maze::recursive_division::divide(uint32_t y, uint32_t x, uint32_t height, u
   }
   else if (vertical == orientation)
   {
-    /* Not enough space, stop. */
-    if (width < 5u)
+    /* Not enough space for the wall or for the hole in it, stop. */
+    if ((width < 5u) || (height < 3u))
     {
       return;
     }
 
-    /* Random place for the wall and for the hole. */
-    std::uniform_int_distribution<uint32_t> random_wall(2u, width-3u);
-    std::uniform_int_distribution<uint32_t> random_hole(1u, height-2u);
+    /* Random place for the wall (2 ... width-3) and for the hole (1 ... height-2). */
     /* Make sure, that the wall is on an even coordinate and the hole is on an odd coordinate. */
-    new_wall = x + (random_wall(random_generator)/2u*2u);
-    new_hole = y + (random_hole(random_generator)/2u*2u+1u);
+    new_wall = x + ((bounded(random_generator, width-4u)+2u)/2u*2u);
+    new_hole = y + ((bounded(random_generator, height-2u)+1u)/2u*2u+1u);
 
     /* Place the wall. */
     for (uint32_t i = y; i < (y+height-1u); i++)
     {
-      area[i][new_wall] = wall;
+      target(i, new_wall) = wall;
     }
     /* Place the hole. */
-    area[new_hole][new_wall] = hole;
+    target(new_hole, new_wall) = hole;
 
     /* Calculate the new values for the next run. */
     new_height = height;
@@ -139,9 +233,21 @@ void maze::recursive_division::divide(uint32_t y, uint32_t x, uint32_t height, u
     /* Do nothing. */
   }
 
+  /* The streams of the two halves. */
+  uint64_t stream_first = random_generator();
+  uint64_t stream_pair = random_generator();
+
   /* Call it again. */
-  divide(y, x, new_height, new_width);
+  /* The two halves don't share any cell, so the big ones can run on another thread. */
+  if ((nullptr != pool) && ((static_cast<uint64_t>(new_height)*new_width) > parallel_threshold))
+  {
+    pool->push([this, &target, stream_first, y, x, new_height, new_width]() { divide(target, stream_first, y, x, new_height, new_width); });
+  }
+  else
+  {
+    divide(target, stream_first, y, x, new_height, new_width);
+  }
   /* When there are no more places left, then go to the 'other side'. */
-  divide(y_pair, x_pair, new_height_pair, new_width_pair);
+  divide(target, stream_pair, y_pair, x_pair, new_height_pair, new_width_pair);
 }
 
@@ -11,6 +11,8 @@
 #define RECURSIVE_DIVISION_H_
 
 #include "maze_generator.h"
+#include "random.h"
+#include "task_pool.h"
 
 namespace maze
 {
@@ -19,9 +21,21 @@ namespace maze
     public:
       using maze_generator::maze_generator;
       void generate(void);
+      void generate(packed_grid &target);
+      void generate(uint64_t new_seed);
+      void generate(packed_grid &target, uint64_t new_seed);
+
+      void set_threads(uint32_t new_threads);
 
     private:
-      void divide(uint32_t y, uint32_t x, uint32_t height, uint32_t width);
+      static constexpr uint64_t parallel_threshold = 128u*128u; /**< Smaller areas are divided on the same thread. */
+
+      uint32_t threads = 1u;
+      task_pool *pool = nullptr;
+
+      template <typename surface> void build(surface &target, uint32_t thread_count);
+      template <typename surface> void clear(surface &target, uint32_t first, uint32_t last);
+      template <typename surface> void divide(surface &target, uint64_t stream, uint32_t y, uint32_t x, uint32_t height, uint32_t width);
   };
 }
 
@@ -0,0 +1,352 @@
+/**
+ * @file    bitplane_wave.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Breadth-first search on bit planes: one bit per cell, 64 cells in a word.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "bitplane_wave.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BITPLANE_WAVE_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief   Constructor. Saves the holes of the maze into the open plane.
+ *          AVX2 is used, if the processor has it, no matter how the rest of the program has been compiled.
+ * @param   vect - View of the maze. It isn't changed and isn't needed after the constructor.
+ * @return  void
+ */
+maze::bitplane_wave::bitplane_wave(grid_view vect) : height(vect.get_height()), width(vect.get_width())
+{
+  tiles_y = (height+side-1u)/side;
+  tiles_x = (width+side-1u)/side;
+#ifdef BITPLANE_WAVE_AVX2
+  avx2 = __builtin_cpu_supports("avx2");
+#else
+  avx2 = false;
+#endif
+
+  size_t words = static_cast<size_t>(tiles_y)*tiles_x*side;
+  open.assign(words, 0u);
+  for (uint32_t y = 0u; y < height; y++)
+  {
+    const uint8_t *row = &vect(y, 0u);
+    for (uint32_t x = 0u; x < width; x += side)
+    {
+      uint64_t bits = 0u;
+      uint32_t count = std::min(static_cast<uint32_t>(side), width-x);
+      for (uint32_t i = 0u; i < count; i++)
+      {
+        bits |= static_cast<uint64_t>(maze_generator::hole == row[x+i]) << i;
+      }
+      open[word(y, x)] = bits;
+    }
+  }
+}
+
+/**
+ * @brief   Runs the search from a cell, until it reaches another one or there is nothing left to reach.
+ *          It can be called any number of times, every call starts from scratch.
+ * @param   start_y - Y coordinate of the start.
+ * @param   start_x - X coordinate of the start.
+ * @param   stop_y  - Y coordinate of the cell, where it stops.
+ * @param   stop_x  - X coordinate of the cell, where it stops.
+ * @return  Distance of the stop from the start, or unreached.
+ */
+uint32_t maze::bitplane_wave::run(uint32_t start_y, uint32_t start_x, uint32_t stop_y, uint32_t stop_x)
+{
+  if ((height <= start_y) || (width <= start_x) || (height <= stop_y) || (width <= stop_x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  if (!((open[word(start_y, start_x)] >> (start_x % side)) & 1u))
+  {
+    throw std::invalid_argument("The start must be a hole (1).");
+  }
+
+  size_t words = open.size();
+  visited.assign(words, 0u);
+  front.assign(words, 0u);
+  next.assign(words, 0u);
+  low.assign(words, 0u);
+  high.assign(words, 0u);
+  stamp.assign(static_cast<size_t>(tiles_y)*tiles_x, static_cast<uint32_t>(unreached));
+  lowest.assign(stamp.size(), 0u);
+  highest.assign(stamp.size(), 0u);
+
+  visited[word(start_y, start_x)] |= static_cast<uint64_t>(1u) << (start_x % side);
+  front[word(start_y, start_x)] |= static_cast<uint64_t>(1u) << (start_x % side);
+  if ((start_y == stop_y) && (start_x == stop_x))
+  {
+    return 0u;
+  }
+
+  std::vector<extent> active(1u, extent{(start_y/side)*tiles_x + start_x/side, start_y % side, (start_y % side)+1u,
+                                         static_cast<uint64_t>(1u) << (start_x % side)});
+  std::vector<extent> still_active;
+  uint32_t level = 0u;
+
+  while (!active.empty())
+  {
+    /* The front can only move one row up or down inside a tile, or into the edge of a neighbouring tile. */
+    stepped.clear();
+    for (const extent &part : active)
+    {
+      uint32_t tile_y = part.tile/tiles_x;
+      uint32_t tile_x = part.tile%tiles_x;
+      widen(part.tile, level, (part.from > 0u) ? (part.from-1u) : 0u, (part.to < side) ? (part.to+1u) : side);
+      if ((0u == part.from) && (tile_y > 0u))
+      {
+        widen(part.tile-tiles_x, level, side-1u, side);
+      }
+      if ((side == part.to) && ((tile_y+1u) < tiles_y))
+      {
+        widen(part.tile+tiles_x, level, 0u, 1u);
+      }
+      if ((part.columns & 1u) && (tile_x > 0u))
+      {
+        widen(part.tile-1u, level, part.from, part.to);
+      }
+      if ((part.columns >> (side-1u)) && ((tile_x+1u) < tiles_x))
+      {
+        widen(part.tile+1u, level, part.from, part.to);
+      }
+    }
+
+    still_active.clear();
+    for (uint32_t tile : stepped)
+    {
+      extent part;
+      if (step(tile, level, part))
+      {
+        still_active.push_back(part);
+      }
+    }
+
+    /* The old front is cleared, so it can be the next one after the swap. */
+    for (const extent &part : active)
+    {
+      size_t first = static_cast<size_t>(part.tile)*side;
+      std::fill(front.begin()+first+part.from, front.begin()+first+part.to, 0u);
+    }
+    front.swap(next);
+    active.swap(still_active);
+    level++;
+
+    if (reached(stop_y, stop_x))
+    {
+      return level;
+    }
+  }
+  return unreached;
+}
+
+/**
+ * @brief   Checks whether a cell has been reached by the last run().
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  True if it has been reached.
+ */
+bool maze::bitplane_wave::reached(uint32_t y, uint32_t x) const
+{
+  return (visited[word(y, x)] >> (x % side)) & 1u;
+}
+
+/**
+ * @brief   Returns the distance of a reached cell from the start, modulo 3.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Distance modulo 3.
+ */
+uint32_t maze::bitplane_wave::level(uint32_t y, uint32_t x) const
+{
+  size_t index = word(y, x);
+  return static_cast<uint32_t>((((high[index] >> (x % side)) & 1u) << 1u) | ((low[index] >> (x % side)) & 1u));
+}
+
+/**
+ * @brief   Returns the word of a cell. The words of a tile are after each other, one for every row.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Index of the word, the cell is bit x%64 of it.
+ */
+size_t maze::bitplane_wave::word(uint32_t y, uint32_t x) const
+{
+  return (static_cast<size_t>(y/side)*tiles_x + x/side)*side + (y % side);
+}
+
+/**
+ * @brief   Adds rows to the ones, that will be stepped in a tile.
+ * @param   tile  - The tile.
+ * @param   level - Distance of the current front from the start.
+ * @param   from  - First row.
+ * @param   to    - One after the last row.
+ * @return  void
+ */
+void maze::bitplane_wave::widen(uint32_t tile, uint32_t level, uint32_t from, uint32_t to)
+{
+  if (level != stamp[tile])
+  {
+    stamp[tile] = level;
+    lowest[tile] = from;
+    highest[tile] = to;
+    stepped.push_back(tile);
+  }
+  else
+  {
+    lowest[tile] = std::min(lowest[tile], from);
+    highest[tile] = std::max(highest[tile], to);
+  }
+}
+
+/**
+ * @brief   Steps the front of a tile by one, in the rows set by widen(). The rows above and below, and the words on the two sides are needed too.
+ * @param   tile    - The tile.
+ * @param   level   - Distance of the current front from the start.
+ * @param   result  - Where the new front is in the tile.
+ * @return  True if the tile has a new front.
+ */
+bool maze::bitplane_wave::step(uint32_t tile, uint32_t level, extent &result)
+{
+  static const uint64_t nothing[side] = {0u};
+  uint32_t tile_y = tile/tiles_x;
+  uint32_t tile_x = tile%tiles_x;
+  size_t first = static_cast<size_t>(tile)*side;
+
+  /* Four rows at a time, for AVX2. */
+  uint32_t from = lowest[tile] & ~3u;
+  uint32_t to = (highest[tile]+3u) & ~3u;
+
+  /* The front of the tile from one row higher to one row lower, row i is at rows[i+1]. */
+  uint64_t rows[side+2u];
+  rows[from] = (from > 0u) ? front[first+from-1u] : ((tile_y > 0u) ? front[first-tiles_x*side+side-1u] : 0u);
+  std::copy(front.begin()+first+from, front.begin()+first+to, rows+from+1u);
+  rows[to+1u] = (to < side) ? front[first+to] : (((tile_y+1u) < tiles_y) ? front[first+tiles_x*side] : 0u);
+  const uint64_t *left = (tile_x > 0u) ? &front[first-side] : nothing;
+  const uint64_t *right = ((tile_x+1u) < tiles_x) ? &front[first+side] : nothing;
+
+  uint32_t remainder = (level+1u) % 3u;
+  uint64_t low_mask = (remainder & 1u) ? UINT64_MAX : 0u;
+  uint64_t high_mask = (remainder & 2u) ? UINT64_MAX : 0u;
+
+  uint64_t columns;
+  if (avx2)
+  {
+    columns = step_avx2(rows, left, right, &open[first], &visited[first], &next[first], &low[first], &high[first], low_mask, high_mask, from, to);
+  }
+  else
+  {
+    columns = step_words(rows, left, right, &open[first], &visited[first], &next[first], &low[first], &high[first], low_mask, high_mask, from, to);
+  }
+  if (0u == columns)
+  {
+    return false;
+  }
+
+  while (0u == next[first+from])
+  {
+    from++;
+  }
+  while (0u == next[first+to-1u])
+  {
+    to--;
+  }
+  result = extent{tile, from, to, columns};
+  return true;
+}
+
+/**
+ * @brief   Steps the front of a tile, one word (64 cells) at a time.
+ * @param   *rows       - The front of the tile, with one more row above and below.
+ * @param   *left       - The front of the tile on the left.
+ * @param   *right      - The front of the tile on the right.
+ * @param   *open       - The open cells of the tile.
+ * @param   *visited    - The reached cells of the tile, the new front is added.
+ * @param   *next       - The new front of the tile.
+ * @param   *low        - Lower bit of the distance modulo 3, set for the new front, if low_mask is set.
+ * @param   *high       - Upper bit of the distance modulo 3, set for the new front, if high_mask is set.
+ * @param   low_mask    - All ones or zero.
+ * @param   high_mask   - All ones or zero.
+ * @param   from        - First row, multiple of 4.
+ * @param   to          - One after the last row, multiple of 4.
+ * @return  The rows of the new front ORed together.
+ */
+uint64_t maze::bitplane_wave::step_words(const uint64_t *rows, const uint64_t *left, const uint64_t *right, const uint64_t *open, uint64_t *visited,
+                                         uint64_t *next, uint64_t *low, uint64_t *high, uint64_t low_mask, uint64_t high_mask, uint32_t from, uint32_t to)
+{
+  uint64_t any = 0u;
+  for (uint32_t i = from; i < to; i++)
+  {
+    uint64_t current = rows[i+1u];
+    uint64_t spread = rows[i] | rows[i+2u] | (current << 1u) | (left[i] >> 63u) | (current >> 1u) | (right[i] << 63u);
+    uint64_t reached = spread & open[i] & ~visited[i];
+    next[i] = reached;
+    visited[i] |= reached;
+    low[i] |= reached & low_mask;
+    high[i] |= reached & high_mask;
+    any |= reached;
+  }
+  return any;
+}
+
+#ifdef BITPLANE_WAVE_AVX2
+/**
+ * @brief   Steps the front of a tile with AVX2, four rows (256 cells) at a time. The same as step_words().
+ * @param   *rows       - The front of the tile, with one more row above and below.
+ * @param   *left       - The front of the tile on the left.
+ * @param   *right      - The front of the tile on the right.
+ * @param   *open       - The open cells of the tile.
+ * @param   *visited    - The reached cells of the tile, the new front is added.
+ * @param   *next       - The new front of the tile.
+ * @param   *low        - Lower bit of the distance modulo 3, set for the new front, if low_mask is set.
+ * @param   *high       - Upper bit of the distance modulo 3, set for the new front, if high_mask is set.
+ * @param   low_mask    - All ones or zero.
+ * @param   high_mask   - All ones or zero.
+ * @param   from        - First row, multiple of 4.
+ * @param   to          - One after the last row, multiple of 4.
+ * @return  The rows of the new front ORed together.
+ */
+__attribute__((target("avx2")))
+uint64_t maze::bitplane_wave::step_avx2(const uint64_t *rows, const uint64_t *left, const uint64_t *right, const uint64_t *open, uint64_t *visited,
+                                        uint64_t *next, uint64_t *low, uint64_t *high, uint64_t low_mask, uint64_t high_mask, uint32_t from, uint32_t to)
+{
+  __m256i any = _mm256_setzero_si256();
+  __m256i lows = _mm256_set1_epi64x(static_cast<long long>(low_mask));
+  __m256i highs = _mm256_set1_epi64x(static_cast<long long>(high_mask));
+  for (uint32_t i = from; i < to; i += 4u)
+  {
+    __m256i above = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows+i));
+    __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows+i+1u));
+    __m256i below = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows+i+2u));
+    __m256i west = _mm256_srli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(left+i)), 63);
+    __m256i east = _mm256_slli_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(right+i)), 63);
+    __m256i spread = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(above, below), _mm256_or_si256(west, east)),
+                                     _mm256_or_si256(_mm256_slli_epi64(current, 1), _mm256_srli_epi64(current, 1)));
+    __m256i seen = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(visited+i));
+    __m256i reached = _mm256_andnot_si256(seen, _mm256_and_si256(spread, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(open+i))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(next+i), reached);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(visited+i), _mm256_or_si256(seen, reached));
+    __m256i old_low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(low+i));
+    __m256i old_high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(high+i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(low+i), _mm256_or_si256(old_low, _mm256_and_si256(reached, lows)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(high+i), _mm256_or_si256(old_high, _mm256_and_si256(reached, highs)));
+    any = _mm256_or_si256(any, reached);
+  }
+  __m128i half = _mm_or_si128(_mm256_castsi256_si128(any), _mm256_extracti128_si256(any, 1));
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(half)) | static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+}
+#else
+/**
+ * @brief   Without AVX2 it is the same as step_words().
+ * @return  The rows of the new front ORed together.
+ */
+uint64_t maze::bitplane_wave::step_avx2(const uint64_t *rows, const uint64_t *left, const uint64_t *right, const uint64_t *open, uint64_t *visited,
+                                        uint64_t *next, uint64_t *low, uint64_t *high, uint64_t low_mask, uint64_t high_mask, uint32_t from, uint32_t to)
+{
+  return step_words(rows, left, right, open, visited, next, low, high, low_mask, high_mask, from, to);
+}
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file    bucket_queue.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Priority queue with small integer priorities, for the solvers.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef BUCKET_QUEUE_H_
+#define BUCKET_QUEUE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace maze
+{
+  /**
+   * Every priority has its own bucket (a stack), the lowest one is taken first.
+   * The priorities in the queue must be within a span of the lowest one, and they never go below it,
+   * so the buckets can be reused in a circle. There is no comparison or sorting at all.
+   */
+  template <typename element>
+  class bucket_queue
+  {
+    public:
+      explicit bucket_queue(uint64_t span)
+      {
+        uint64_t size = 1u;
+        while (size < span)
+        {
+          size <<= 1u;
+        }
+        buckets.resize(size);
+      }
+
+      bool empty(void) const { return 0u == count; }
+
+      void push(uint64_t priority, const element &value)
+      {
+        if ((0u == count) || (priority < lowest))
+        {
+          lowest = priority;
+        }
+        buckets[priority & (buckets.size()-1u)].push_back(value);
+        count++;
+      }
+
+      /* The lowest priority in the queue. It must not be empty. */
+      uint64_t top(void)
+      {
+        while (buckets[lowest & (buckets.size()-1u)].empty())
+        {
+          lowest++;
+        }
+        return lowest;
+      }
+
+      /* Removes one of the elements with the lowest priority, the last pushed one. It must not be empty. */
+      element pop(void)
+      {
+        std::vector<element> &bucket = buckets[top() & (buckets.size()-1u)];
+        element value = bucket.back();
+        bucket.pop_back();
+        count--;
+        return value;
+      }
+
+    private:
+      std::vector<std::vector<element>> buckets;
+      uint64_t lowest = 0u;
+      size_t count = 0u;
+  };
+}
+
+#endif /* BUCKET_QUEUE_H_ */
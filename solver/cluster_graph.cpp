@@ -0,0 +1,389 @@
+/**
+ * @file    cluster_graph.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Abstract graph of a maze split into square clusters, for hierarchical path finding.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "cluster_graph.h"
+
+/**
+ * @brief   Constructor. Finds the transitions between the clusters, then the distances between the nodes of every cluster.
+ * @param   vect - View of the maze. It isn't changed, but the solver needs it again for the details.
+ * @param   size - Width and height of the clusters.
+ * @return  void
+ */
+maze::cluster_graph::cluster_graph(grid_view vect, uint32_t size) : height(vect.get_height()), width(vect.get_width()), size(size)
+{
+  if ((2u > size) || (4096u < size))
+  {
+    throw std::invalid_argument("The size of the clusters must be between 2 and 4096.");
+  }
+  columns = (width+size-1u)/size;
+  uint32_t rows = (height+size-1u)/size;
+
+  /* The two sides of every transition, next to each other. */
+  std::vector<solver::coordinate> sides;
+  uint32_t run = 0u;
+  uint32_t run_start = 0u;
+  auto finish_run = [&](bool vertical, uint32_t border)
+  {
+    if (0u != run)
+    {
+      uint32_t middle = run_start+(run-1u)/2u;
+      if (vertical)
+      {
+        sides.push_back({middle, border-1u});
+        sides.push_back({middle, border});
+      }
+      else
+      {
+        sides.push_back({border-1u, middle});
+        sides.push_back({border, middle});
+      }
+      run = 0u;
+    }
+  };
+
+  /* Runs of touching open cells along a border. A run ends at the corner of the clusters too. */
+  for (uint32_t x = size; x < width; x += size)
+  {
+    for (uint32_t y = 0u; y < height; y++)
+    {
+      if (0u == (y % size))
+      {
+        finish_run(true, x);
+      }
+      if ((wall != vect(y, x-1u)) && (wall != vect(y, x)))
+      {
+        run_start = (0u == run) ? y : run_start;
+        run++;
+      }
+      else
+      {
+        finish_run(true, x);
+      }
+    }
+    finish_run(true, x);
+  }
+  for (uint32_t y = size; y < height; y += size)
+  {
+    for (uint32_t x = 0u; x < width; x++)
+    {
+      if (0u == (x % size))
+      {
+        finish_run(false, y);
+      }
+      if ((wall != vect(y-1u, x)) && (wall != vect(y, x)))
+      {
+        run_start = (0u == run) ? x : run_start;
+        run++;
+      }
+      else
+      {
+        finish_run(false, y);
+      }
+    }
+    finish_run(false, y);
+  }
+
+  if (sides.size() >= none)
+  {
+    throw std::invalid_argument("The maze has too many transitions for the graph.");
+  }
+
+  /* The nodes are numbered cluster by cluster, so the nodes of a cluster are next to each other. */
+  first_node.assign(static_cast<size_t>(rows)*columns+1u, 0u);
+  for (const solver::coordinate &side : sides)
+  {
+    first_node[cluster(side.y, side.x)+1u]++;
+  }
+  for (size_t i = 1u; i < first_node.size(); i++)
+  {
+    first_node[i] += first_node[i-1u];
+  }
+  std::vector<uint32_t> number(sides.size());
+  std::vector<uint32_t> next_node(first_node.begin(), first_node.end()-1u);
+  node_at.resize(sides.size());
+  for (size_t i = 0u; i < sides.size(); i++)
+  {
+    number[i] = next_node[cluster(sides[i].y, sides[i].x)]++;
+    node_at[number[i]] = sides[i];
+  }
+  std::vector<uint32_t> partner(sides.size());
+  for (size_t i = 0u; i < sides.size(); i++)
+  {
+    partner[number[i]] = number[i ^ 1u];
+  }
+
+  /* Every node: one step to the other side of its transition, then the distances to the nodes of its own cluster. */
+  std::vector<uint32_t> steps;
+  std::vector<uint8_t> back;
+  first_link.assign(node_at.size()+1u, 0u);
+  for (uint32_t node = 0u; node < node_at.size(); node++)
+  {
+    links.push_back({partner[node], 1u});
+    flood(vect, node_at[node].y, node_at[node].x, steps, back);
+    uint32_t own = cluster(node_at[node].y, node_at[node].x);
+    for (uint32_t other = first_node[own]; other < first_node[own+1u]; other++)
+    {
+      uint32_t distance = steps[local(node_at[other].y, node_at[other].x)];
+      if ((other != node) && (none != distance))
+      {
+        links.push_back({other, distance});
+      }
+    }
+    first_link[node+1u] = static_cast<uint32_t>(links.size());
+  }
+}
+
+/**
+ * @brief   Breadth-first search from a cell, that doesn't leave the cluster of the cell.
+ * @param   vect    - View of the maze.
+ * @param   y       - Y coordinate of the cell.
+ * @param   x       - X coordinate of the cell.
+ * @param   &steps  - Distance of every cell of the cluster from the cell (see local()), none if it can't be reached.
+ * @param   &back   - Direction back towards the cell, for trace().
+ * @param   until   - Stop, when this cell (see local()) is reached. By default the whole cluster is searched.
+ * @return  void
+ */
+void maze::cluster_graph::flood(grid_view vect, uint32_t y, uint32_t x, std::vector<uint32_t> &steps, std::vector<uint8_t> &back, uint32_t until) const
+{
+  uint32_t top = y-(y % size);
+  uint32_t left = x-(x % size);
+  uint32_t bottom = std::min(top+size, height);
+  uint32_t right = std::min(left+size, width);
+
+  steps.assign(size*size, static_cast<uint32_t>(none));
+  back.assign(size*size, static_cast<uint8_t>(source));
+  /* The front keeps the coordinates too, so there is no division in the loop. */
+  std::vector<solver::coordinate> front;
+  front.reserve(size*size);
+
+  /* Saves a neighbour into the front, if it is open and it hasn't been reached yet. */
+  auto reach = [&](uint32_t next_y, uint32_t next_x, uint32_t cell, uint8_t direction, uint32_t distance)
+  {
+    if ((none == steps[cell]) && (wall != vect(next_y, next_x)))
+    {
+      steps[cell] = distance;
+      back[cell] = direction;
+      front.push_back({next_y, next_x});
+    }
+  };
+
+  steps[local(y, x)] = 0u;
+  front.push_back({y, x});
+  for (size_t i = 0u; i < front.size(); i++)
+  {
+    uint32_t current_y = front[i].y;
+    uint32_t current_x = front[i].x;
+    uint32_t cell = (current_y-top)*size + (current_x-left);
+    if (cell == until)
+    {
+      break;
+    }
+    uint32_t distance = steps[cell]+1u;
+    if (current_y > top)
+    {
+      reach(current_y-1u, current_x, cell-size, south, distance);
+    }
+    if ((current_y+1u) < bottom)
+    {
+      reach(current_y+1u, current_x, cell+size, north, distance);
+    }
+    if (current_x > left)
+    {
+      reach(current_y, current_x-1u, cell-1u, east, distance);
+    }
+    if ((current_x+1u) < right)
+    {
+      reach(current_y, current_x+1u, cell+1u, west, distance);
+    }
+  }
+}
+
+/**
+ * @brief   Walks back from a cell to the start of the last flood() of its cluster, and marks every cell on the way.
+ * @param   vect    - View of the maze.
+ * @param   y       - Y coordinate of the cell.
+ * @param   x       - X coordinate of the cell.
+ * @param   &back   - Directions from flood().
+ * @param   value   - The cells are set to this.
+ * @return  void
+ */
+void maze::cluster_graph::trace(grid_view vect, uint32_t y, uint32_t x, const std::vector<uint8_t> &back, uint8_t value) const
+{
+  uint8_t direction = back[local(y, x)];
+  vect(y, x) = value;
+  while (source != direction)
+  {
+    if (north == direction)
+    {
+      y--;
+    }
+    else if (south == direction)
+    {
+      y++;
+    }
+    else if (west == direction)
+    {
+      x--;
+    }
+    else
+    {
+      x++;
+    }
+    direction = back[local(y, x)];
+    vect(y, x) = value;
+  }
+}
+
+/**
+ * @brief   Walks back from a cell to the start of the last flood() of its cluster, like the other trace(),
+ *          but saves the moves instead of marking the cells.
+ * @param   y       - Y coordinate of the cell.
+ * @param   x       - X coordinate of the cell.
+ * @param   &back   - Directions from flood().
+ * @param   &moves  - The moves in the order of the walk: north, south, west or east.
+ * @return  void
+ */
+void maze::cluster_graph::trace(uint32_t y, uint32_t x, const std::vector<uint8_t> &back, std::vector<uint8_t> &moves) const
+{
+  uint8_t direction = back[local(y, x)];
+  moves.clear();
+  while (source != direction)
+  {
+    moves.push_back(direction);
+    if (north == direction)
+    {
+      y--;
+    }
+    else if (south == direction)
+    {
+      y++;
+    }
+    else if (west == direction)
+    {
+      x--;
+    }
+    else
+    {
+      x++;
+    }
+    direction = back[local(y, x)];
+  }
+}
+
+/**
+ * @brief   Returns the index of a cell inside its cluster, for flood().
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Index of the cell.
+ */
+uint32_t maze::cluster_graph::local(uint32_t y, uint32_t x) const
+{
+  return (y % size)*size + (x % size);
+}
+
+/**
+ * @brief   Returns the cluster of a cell.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Cluster.
+ */
+uint32_t maze::cluster_graph::cluster(uint32_t y, uint32_t x) const
+{
+  return (y/size)*columns + x/size;
+}
+
+/**
+ * @brief   Returns the first node of a cluster.
+ * @param   cluster - The cluster.
+ * @return  First node.
+ */
+uint32_t maze::cluster_graph::nodes_begin(uint32_t cluster) const
+{
+  return first_node[cluster];
+}
+
+/**
+ * @brief   Returns the node after the last node of a cluster.
+ * @param   cluster - The cluster.
+ * @return  Node after the last one.
+ */
+uint32_t maze::cluster_graph::nodes_end(uint32_t cluster) const
+{
+  return first_node[cluster+1u];
+}
+
+/**
+ * @brief   Returns the y coordinate of a node.
+ * @param   node - The node.
+ * @return  y
+ */
+uint32_t maze::cluster_graph::get_y(uint32_t node) const
+{
+  return node_at[node].y;
+}
+
+/**
+ * @brief   Returns the x coordinate of a node.
+ * @param   node - The node.
+ * @return  x
+ */
+uint32_t maze::cluster_graph::get_x(uint32_t node) const
+{
+  return node_at[node].x;
+}
+
+/**
+ * @brief   Returns the number of nodes.
+ * @param   void
+ * @return  nodes
+ */
+uint32_t maze::cluster_graph::get_nodes(void) const
+{
+  return static_cast<uint32_t>(node_at.size());
+}
+
+/**
+ * @brief   Returns the number of links (every edge is counted from both ends).
+ * @param   void
+ * @return  links
+ */
+uint32_t maze::cluster_graph::get_links(void) const
+{
+  return static_cast<uint32_t>(links.size());
+}
+
+/**
+ * @brief   Returns the size of the clusters.
+ * @param   void
+ * @return  size
+ */
+uint32_t maze::cluster_graph::get_size(void) const
+{
+  return size;
+}
+
+/**
+ * @brief   Returns the height of the maze.
+ * @param   void
+ * @return  height
+ */
+uint32_t maze::cluster_graph::get_height(void) const
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the maze.
+ * @param   void
+ * @return  width
+ */
+uint32_t maze::cluster_graph::get_width(void) const
+{
+  return width;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file    cluster_graph.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Abstract graph of a maze split into square clusters, for hierarchical path finding.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef CLUSTER_GRAPH_H_
+#define CLUSTER_GRAPH_H_
+
+#include <vector>
+#include <stdexcept>
+#include "solver.h"
+
+namespace maze
+{
+  /**
+   * The maze is split into square clusters. Where the open cells of two neighbour clusters touch, the middle of every touching
+   * run is a transition: a node on both sides, with a single step between them. Inside a cluster the distances between its nodes
+   * are found once, with a search that doesn't leave the cluster. A solution is searched on these nodes first (solver::hierarchical()),
+   * then only the clusters along it are searched cell by cell.
+   * In a perfect maze the path is the shortest one. With loops and rooms it can be a bit longer: only one cell of a touching run is used.
+   */
+  class cluster_graph
+  {
+    public:
+      /* A neighbour of a node. */
+      struct link {
+        uint32_t node;
+        uint32_t weight;
+      };
+
+      static constexpr uint32_t none = UINT32_MAX;
+
+      explicit cluster_graph(grid_view vect, uint32_t size = 64u);
+
+      void flood(grid_view vect, uint32_t y, uint32_t x, std::vector<uint32_t> &steps, std::vector<uint8_t> &back, uint32_t until = none) const;
+      void trace(grid_view vect, uint32_t y, uint32_t x, const std::vector<uint8_t> &back, uint8_t value) const;
+      void trace(uint32_t y, uint32_t x, const std::vector<uint8_t> &back, std::vector<uint8_t> &moves) const;
+      uint32_t local(uint32_t y, uint32_t x) const;
+
+      /**
+       * @brief   Returns the neighbours of a node.
+       * @param   node - The node.
+       * @return  Pointer to the first neighbour, the last one is before links_end(node).
+       */
+      const link *links_begin(uint32_t node) const { return links.data()+first_link[node]; }
+      const link *links_end(uint32_t node) const { return links.data()+first_link[node+1u]; }
+
+      uint32_t cluster(uint32_t y, uint32_t x) const;
+      uint32_t nodes_begin(uint32_t cluster) const;
+      uint32_t nodes_end(uint32_t cluster) const;
+
+      uint32_t get_y(uint32_t node) const;
+      uint32_t get_x(uint32_t node) const;
+      uint32_t get_nodes(void) const;
+      uint32_t get_links(void) const;
+      uint32_t get_size(void) const;
+      uint32_t get_height(void) const;
+      uint32_t get_width(void) const;
+
+    private:
+      static constexpr uint8_t wall   = maze_generator::wall;
+      static constexpr uint8_t north  = 0u;
+      static constexpr uint8_t south  = 1u;
+      static constexpr uint8_t west   = 2u;
+      static constexpr uint8_t east   = 3u;
+      static constexpr uint8_t source = 4u;
+
+      uint32_t height;
+      uint32_t width;
+      uint32_t size;
+      uint32_t columns;                       /**< Clusters in a row. */
+
+      std::vector<solver::coordinate> node_at;
+      std::vector<uint32_t> first_node;       /**< The nodes of a cluster are first_node[cluster] ... first_node[cluster+1]-1. */
+      std::vector<uint32_t> first_link;       /**< The neighbours of a node are links[first_link[node]] ... links[first_link[node+1]-1]. */
+      std::vector<link> links;
+  };
+}
+
+#endif /* CLUSTER_GRAPH_H_ */
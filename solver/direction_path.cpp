@@ -0,0 +1,247 @@
+/**
+ * @file    direction_path.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   A path as its first cell and a list of 2-bit steps.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "direction_path.h"
+
+/**
+ * @brief   Constructor. The path is empty and not found.
+ * @param   void
+ * @return  void
+ */
+maze::direction_path::direction_path(void) : found(false), start_y(0u), start_x(0u), length(0u)
+{
+
+}
+
+/**
+ * @brief   Empties the path: there is no solution.
+ * @param   void
+ * @return  void
+ */
+void maze::direction_path::clear(void)
+{
+  found = false;
+  start_y = 0u;
+  start_x = 0u;
+  length = 0u;
+  steps.clear();
+}
+
+/**
+ * @brief   Starts a found path with the given number of steps, all of them north. They can be changed with set_step().
+ *          A path with no steps is only the first cell.
+ * @param   start_y - Y coordinate of the first cell.
+ * @param   start_x - X coordinate of the first cell.
+ * @param   length  - Number of steps.
+ * @return  void
+ */
+void maze::direction_path::reset(uint32_t start_y, uint32_t start_x, uint64_t length)
+{
+  found = true;
+  this->start_y = start_y;
+  this->start_x = start_x;
+  this->length = length;
+  steps.assign(static_cast<size_t>((length+per_word-1u)/per_word), 0u);
+}
+
+/**
+ * @brief   Adds a step to the end of the path, and marks the path as found.
+ *          The first cell is set by reset(); after clear() the path starts at [0,0].
+ * @param   direction - North, south, west or east.
+ * @return  void
+ */
+void maze::direction_path::push(uint8_t direction)
+{
+  found = true;
+  if (0u == (length % per_word))
+  {
+    steps.push_back(0u);
+  }
+  length++;
+  set_step(length-1u, direction);
+}
+
+/**
+ * @brief   Changes a step of the path.
+ * @param   index     - The step.
+ * @param   direction - North, south, west or east.
+ * @return  void
+ */
+void maze::direction_path::set_step(uint64_t index, uint8_t direction)
+{
+  if (length <= index)
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  uint32_t shift = static_cast<uint32_t>(index % per_word)*2u;
+  uint64_t &word = steps[static_cast<size_t>(index/per_word)];
+  word = (word & ~(static_cast<uint64_t>(3u) << shift)) | (static_cast<uint64_t>(direction & 3u) << shift);
+}
+
+/**
+ * @brief   Returns a step of the path.
+ * @param   index - The step.
+ * @return  North, south, west or east.
+ */
+uint8_t maze::direction_path::get_step(uint64_t index) const
+{
+  if (length <= index)
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  return static_cast<uint8_t>((steps[static_cast<size_t>(index/per_word)] >> ((index % per_word)*2u)) & 3u);
+}
+
+/**
+ * @brief   Writes the path into a maze: every cell of it gets the value. The rest of the maze isn't touched.
+ *          If the path leaves the maze, it throws before anything is written.
+ * @param   vect  - View of the maze.
+ * @param   value - Value of the cells of the path.
+ * @return  void
+ */
+void maze::direction_path::stamp(grid_view vect, uint8_t value) const
+{
+  if (!found)
+  {
+    return;
+  }
+  if ((vect.get_height() <= start_y) || (vect.get_width() <= start_x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+
+  /* The first pass only walks the path, the second one writes it. */
+  for (uint32_t pass = 0u; pass < 2u; pass++)
+  {
+    bool write = (1u == pass);
+    uint32_t y = start_y;
+    uint32_t x = start_x;
+    if (write)
+    {
+      vect(y, x) = value;
+    }
+    for (size_t i = 0u; i < steps.size(); i++)
+    {
+      uint64_t word = steps[i];
+      uint64_t count = std::min(static_cast<uint64_t>(per_word), length-i*per_word);
+      for (uint64_t j = 0u; j < count; j++, word >>= 2u)
+      {
+        if (!move(static_cast<uint8_t>(word & 3u), vect.get_height(), vect.get_width(), y, x))
+        {
+          throw std::invalid_argument("The path leaves the maze.");
+        }
+        if (write)
+        {
+          vect(y, x) = value;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief   Takes a step, if it stays in the maze.
+ * @param   direction - North, south, west or east.
+ * @param   height    - Height of the maze.
+ * @param   width     - Width of the maze.
+ * @param   &y        - Y coordinate, moved by the step.
+ * @param   &x        - X coordinate, moved by the step.
+ * @return  False if the step would leave the maze, then y and x aren't changed.
+ */
+bool maze::direction_path::move(uint8_t direction, uint32_t height, uint32_t width, uint32_t &y, uint32_t &x)
+{
+  bool inside = true;
+  if ((north == direction) && (y > 0u))
+  {
+    y--;
+  }
+  else if ((south == direction) && ((y+1u) < height))
+  {
+    y++;
+  }
+  else if ((west == direction) && (x > 0u))
+  {
+    x--;
+  }
+  else if ((east == direction) && ((x+1u) < width))
+  {
+    x++;
+  }
+  else
+  {
+    inside = false;
+  }
+  return inside;
+}
+
+/**
+ * @brief   Returns the steps as text, one letter for each: N, S, W or E.
+ * @param   void
+ * @return  The text, empty if there are no steps.
+ */
+std::string maze::direction_path::to_string(void) const
+{
+  static const char letters[4u] = {'N', 'S', 'W', 'E'};
+  std::string text(static_cast<size_t>(length), ' ');
+  for (uint64_t i = 0u; i < length; i++)
+  {
+    text[static_cast<size_t>(i)] = letters[get_step(i)];
+  }
+  return text;
+}
+
+/**
+ * @brief   Returns whether there is a solution.
+ * @param   void
+ * @return  True if found.
+ */
+bool maze::direction_path::is_found(void) const
+{
+  return found;
+}
+
+/**
+ * @brief   Returns the Y coordinate of the first cell.
+ * @param   void
+ * @return  Y coordinate.
+ */
+uint32_t maze::direction_path::get_start_y(void) const
+{
+  return start_y;
+}
+
+/**
+ * @brief   Returns the X coordinate of the first cell.
+ * @param   void
+ * @return  X coordinate.
+ */
+uint32_t maze::direction_path::get_start_x(void) const
+{
+  return start_x;
+}
+
+/**
+ * @brief   Returns the number of steps. The path goes through one more cell.
+ * @param   void
+ * @return  Number of steps.
+ */
+uint64_t maze::direction_path::get_length(void) const
+{
+  return length;
+}
+
+/**
+ * @brief   Returns the packed steps: step i is bits 2*(i%32) and 2*(i%32)+1 of word i/32.
+ * @param   void
+ * @return  The words.
+ */
+const std::vector<uint64_t> &maze::direction_path::get_steps(void) const
+{
+  return steps;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file    direction_path.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   A path as its first cell and a list of 2-bit steps.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef DIRECTION_PATH_H_
+#define DIRECTION_PATH_H_
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include "maze_generator.h"
+
+namespace maze
+{
+  /**
+   * A solution, that is kept apart from the maze: the first cell, the number of steps and a direction for every step,
+   * 32 steps in a word. A path through n cells takes n/4 bytes, so it is cheap to store or send, and the maze is never
+   * marked, unless stamp() is called.
+   */
+  class direction_path
+  {
+    public:
+      static constexpr uint8_t north  = 0u;
+      static constexpr uint8_t south  = 1u;
+      static constexpr uint8_t west   = 2u;
+      static constexpr uint8_t east   = 3u;
+
+      direction_path(void);
+
+      void clear(void);
+      void reset(uint32_t start_y, uint32_t start_x, uint64_t length);
+      void push(uint8_t direction);
+      void set_step(uint64_t index, uint8_t direction);
+      uint8_t get_step(uint64_t index) const;
+
+      void stamp(grid_view vect, uint8_t value = maze_generator::solution) const;
+      std::string to_string(void) const;
+
+      bool is_found(void) const;
+      uint32_t get_start_y(void) const;
+      uint32_t get_start_x(void) const;
+      uint64_t get_length(void) const;
+      const std::vector<uint64_t> &get_steps(void) const;
+
+    private:
+      static constexpr uint32_t per_word = 32u;  /**< Steps in a word. */
+
+      static bool move(uint8_t direction, uint32_t height, uint32_t width, uint32_t &y, uint32_t &x);
+
+      bool found;
+      uint32_t start_y;
+      uint32_t start_x;
+      uint64_t length;
+      std::vector<uint64_t> steps;
+  };
+}
+
+#endif /* DIRECTION_PATH_H_ */
@@ -0,0 +1,265 @@
+/**
+ * @file    distance_map.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Distances from one cell, for answering many path queries with a single search.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "distance_map.h"
+
+/**
+ * @brief   Constructor. Finds the distance of every cell from the source.
+ * @param   vect      - View of the maze. It isn't changed and isn't needed after the constructor.
+ * @param   source_y  - Y coordinate of the source.
+ * @param   source_x  - X coordinate of the source.
+ * @param   threads   - Threads of the search, 0 means every hardware thread.
+ * @return  void
+ */
+maze::distance_map::distance_map(grid_view vect, uint32_t source_y, uint32_t source_x, uint32_t threads) :
+  height(vect.get_height()), width(vect.get_width()), source_y(source_y), source_x(source_x)
+{
+  solver search;
+  search.set_threads(threads);
+  search.distance_field(vect, source_y, source_x, field);
+}
+
+/**
+ * @brief   Returns the length of the shortest path between the source and a cell.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Number of steps, or unreached.
+ */
+uint32_t maze::distance_map::distance(uint32_t y, uint32_t x) const
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  return field[static_cast<size_t>(y)*width+x];
+}
+
+/**
+ * @brief   Appends the cells of a shortest path from the source to a cell (both of them included).
+ * @param   y     - Y coordinate of the cell.
+ * @param   x     - X coordinate of the cell.
+ * @param   route - The cells are added to its end.
+ * @return  False if the cell can't be reached, then nothing is added.
+ */
+bool maze::distance_map::route_from_source(uint32_t y, uint32_t x, std::vector<solver::coordinate> &route) const
+{
+  return this->route(y, x, false, route);
+}
+
+/**
+ * @brief   Appends the cells of a shortest path from a cell to the source (both of them included).
+ * @param   y     - Y coordinate of the cell.
+ * @param   x     - X coordinate of the cell.
+ * @param   route - The cells are added to its end.
+ * @return  False if the cell can't be reached, then nothing is added.
+ */
+bool maze::distance_map::route_to_source(uint32_t y, uint32_t x, std::vector<solver::coordinate> &route) const
+{
+  return this->route(y, x, true, route);
+}
+
+/**
+ * @brief   Finds a shortest path from the source to a cell, as directions.
+ * @param   y     - Y coordinate of the cell.
+ * @param   x     - X coordinate of the cell.
+ * @param   path  - The path from the source, not found if the cell can't be reached.
+ * @return  False if the cell can't be reached.
+ */
+bool maze::distance_map::route_from_source(uint32_t y, uint32_t x, direction_path &path) const
+{
+  return route(y, x, false, path);
+}
+
+/**
+ * @brief   Finds a shortest path from a cell to the source, as directions.
+ * @param   y     - Y coordinate of the cell.
+ * @param   x     - X coordinate of the cell.
+ * @param   path  - The path from the cell, not found if the cell can't be reached.
+ * @return  False if the cell can't be reached.
+ */
+bool maze::distance_map::route_to_source(uint32_t y, uint32_t x, direction_path &path) const
+{
+  return route(y, x, true, path);
+}
+
+/**
+ * @brief   Finds a shortest path from the source to every target.
+ * @param   targets - The targets.
+ * @param   paths   - Path i leads to targets[i], it is not found if the target can't be reached. The old content is dropped.
+ * @return  void
+ */
+void maze::distance_map::routes_from_source(const std::vector<solver::coordinate> &targets, std::vector<direction_path> &paths) const
+{
+  routes(targets, false, paths);
+}
+
+/**
+ * @brief   Finds a shortest path from every origin to the source.
+ * @param   origins - The origins.
+ * @param   paths   - Path i starts at origins[i], it is not found if the origin can't be reached. The old content is dropped.
+ * @return  void
+ */
+void maze::distance_map::routes_to_source(const std::vector<solver::coordinate> &origins, std::vector<direction_path> &paths) const
+{
+  routes(origins, true, paths);
+}
+
+/**
+ * @brief   Returns the Y coordinate of the source.
+ * @param   void
+ * @return  Y coordinate.
+ */
+uint32_t maze::distance_map::get_source_y(void) const
+{
+  return source_y;
+}
+
+/**
+ * @brief   Returns the X coordinate of the source.
+ * @param   void
+ * @return  X coordinate.
+ */
+uint32_t maze::distance_map::get_source_x(void) const
+{
+  return source_x;
+}
+
+/**
+ * @brief   Returns the height of the maze.
+ * @param   void
+ * @return  Height.
+ */
+uint32_t maze::distance_map::get_height(void) const
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the maze.
+ * @param   void
+ * @return  Width.
+ */
+uint32_t maze::distance_map::get_width(void) const
+{
+  return width;
+}
+
+/**
+ * @brief   Appends a shortest path between the source and a cell. It walks from the cell to a neighbour, that is one step closer, until the source.
+ * @param   y               - Y coordinate of the cell.
+ * @param   x               - X coordinate of the cell.
+ * @param   towards_source  - The path starts at the cell if true, at the source if false.
+ * @param   route           - The cells are added to its end.
+ * @return  False if the cell can't be reached, then nothing is added.
+ */
+bool maze::distance_map::route(uint32_t y, uint32_t x, bool towards_source, std::vector<solver::coordinate> &route) const
+{
+  uint32_t steps = distance(y, x);
+  if (unreached == steps)
+  {
+    return false;
+  }
+
+  /* The walk goes from the cell, so the other direction is filled from the back. The last cell is the source. */
+  size_t first = route.size();
+  route.resize(first+steps+1u);
+  for (uint32_t i = 0u; i < steps; i++)
+  {
+    route[towards_source ? (first+i) : (first+steps-i)] = solver::coordinate{y, x};
+    downhill(y, x);
+  }
+  route[towards_source ? (first+steps) : first] = solver::coordinate{y, x};
+  return true;
+}
+
+/**
+ * @brief   Finds a shortest path between the source and a cell, as directions. It walks from the cell to the source, like the other route().
+ * @param   y               - Y coordinate of the cell.
+ * @param   x               - X coordinate of the cell.
+ * @param   towards_source  - The path starts at the cell if true, at the source if false.
+ * @param   path            - The path, not found if the cell can't be reached.
+ * @return  False if the cell can't be reached.
+ */
+bool maze::distance_map::route(uint32_t y, uint32_t x, bool towards_source, direction_path &path) const
+{
+  uint32_t steps = distance(y, x);
+  path.clear();
+  if (unreached == steps)
+  {
+    return false;
+  }
+
+  /* Towards the source the moves are the steps. From the source they are filled from the end, and every step is the opposite of the move. */
+  if (towards_source)
+  {
+    path.reset(y, x, steps);
+    for (uint32_t i = 0u; i < steps; i++)
+    {
+      path.set_step(i, downhill(y, x));
+    }
+  }
+  else
+  {
+    path.reset(source_y, source_x, steps);
+    for (uint32_t i = steps; i > 0u; i--)
+    {
+      path.set_step(i-1u, static_cast<uint8_t>(downhill(y, x) ^ 1u));
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief   Finds a shortest path between the source and every end.
+ * @param   ends            - The other ends of the paths.
+ * @param   towards_source  - The paths start at the ends if true, at the source if false.
+ * @param   paths           - Path i belongs to ends[i]. The old content is dropped.
+ * @return  void
+ */
+void maze::distance_map::routes(const std::vector<solver::coordinate> &ends, bool towards_source, std::vector<direction_path> &paths) const
+{
+  paths.resize(ends.size());
+  for (size_t i = 0u; i < ends.size(); i++)
+  {
+    route(ends[i].y, ends[i].x, towards_source, paths[i]);
+  }
+}
+
+/**
+ * @brief   Moves from a cell to a neighbour, that is one step closer to the source. The cell can't be the source.
+ * @param   &y - Y coordinate of the cell, it is moved to the neighbour.
+ * @param   &x - X coordinate of the cell, it is moved to the neighbour.
+ * @return  Direction of the move: north, south, west or east.
+ */
+uint8_t maze::distance_map::downhill(uint32_t &y, uint32_t &x) const
+{
+  size_t here = static_cast<size_t>(y)*width+x;
+  uint32_t closer = field[here]-1u;
+  uint8_t direction = direction_path::east;
+  if ((y > 0u) && (closer == field[here-width]))
+  {
+    y--;
+    direction = direction_path::north;
+  }
+  else if (((y+1u) < height) && (closer == field[here+width]))
+  {
+    y++;
+    direction = direction_path::south;
+  }
+  else if ((x > 0u) && (closer == field[here-1u]))
+  {
+    x--;
+    direction = direction_path::west;
+  }
+  else
+  {
+    x++;
+  }
+  return direction;
+}
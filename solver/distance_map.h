@@ -0,0 +1,61 @@
+/**
+ * @file    distance_map.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Distances from one cell, for answering many path queries with a single search.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef DISTANCE_MAP_H_
+#define DISTANCE_MAP_H_
+
+#include <vector>
+#include <stdexcept>
+#include "solver.h"
+#include "direction_path.h"
+
+namespace maze
+{
+  /**
+   * The distance of every cell from a source, found once with solver::distance_field().
+   * A shortest path between the source and any cell is a walk down the distances, so every query after that
+   * only costs as many steps, as long its path is, and the maze isn't marked.
+   * A path is returned as a direction_path: its first cell and 2 bits for every step, so a batch of long paths stays small.
+   * The maze has no one-way passages, so the same map answers queries towards the source too (many entrances, one exit).
+   */
+  class distance_map
+  {
+    public:
+      static constexpr uint32_t unreached = solver::unreached;
+
+      explicit distance_map(grid_view vect, uint32_t source_y, uint32_t source_x, uint32_t threads = 0u);
+
+      uint32_t distance(uint32_t y, uint32_t x) const;
+      bool route_from_source(uint32_t y, uint32_t x, std::vector<solver::coordinate> &route) const;
+      bool route_to_source(uint32_t y, uint32_t x, std::vector<solver::coordinate> &route) const;
+      bool route_from_source(uint32_t y, uint32_t x, direction_path &path) const;
+      bool route_to_source(uint32_t y, uint32_t x, direction_path &path) const;
+      void routes_from_source(const std::vector<solver::coordinate> &targets, std::vector<direction_path> &paths) const;
+      void routes_to_source(const std::vector<solver::coordinate> &origins, std::vector<direction_path> &paths) const;
+
+      uint32_t get_source_y(void) const;
+      uint32_t get_source_x(void) const;
+      uint32_t get_height(void) const;
+      uint32_t get_width(void) const;
+
+    private:
+      uint32_t height;
+      uint32_t width;
+      uint32_t source_y;
+      uint32_t source_x;
+      std::vector<uint32_t> field;       /**< Distance of every cell from the source, unreached for walls and unconnected cells. */
+
+      uint8_t downhill(uint32_t &y, uint32_t &x) const;
+      bool route(uint32_t y, uint32_t x, bool towards_source, std::vector<solver::coordinate> &route) const;
+      bool route(uint32_t y, uint32_t x, bool towards_source, direction_path &path) const;
+      void routes(const std::vector<solver::coordinate> &ends, bool towards_source, std::vector<direction_path> &paths) const;
+  };
+}
+
+#endif /* DISTANCE_MAP_H_ */
@@ -0,0 +1,425 @@
+/**
+ * @file    incremental_solver.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Keeps a maze solved, while its cells are opened and closed one by one.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "incremental_solver.h"
+
+/**
+ * @brief   Constructor. Copies the maze and finds the distance of every cell from the entrance.
+ * @param   vect        - View of the maze. It isn't changed and isn't needed after the constructor.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+maze::incremental_solver::incremental_solver(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x) :
+  area(vect.get_height(), vect.get_width(), wall), height(vect.get_height()), width(vect.get_width()), changed(0u)
+{
+  for (uint32_t y = 0u; y < height; y++)
+  {
+    std::copy(&vect(y, 0u), &vect(y, 0u)+width, &area(y, 0u));
+  }
+  affected.assign((static_cast<size_t>(height)*width+63u)/64u, 0u);
+  set_exit(exit_y, exit_x);
+  set_entrance(entrance_y, entrance_x);
+}
+
+/**
+ * @brief   Opens or closes a cell, and repairs the distances it changes.
+ * @param   y     - Y coordinate of the cell.
+ * @param   x     - X coordinate of the cell.
+ * @param   value - Wall (0) or hole (1).
+ * @return  void
+ */
+void maze::incremental_solver::set_cell(uint32_t y, uint32_t x, uint32_t value)
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  else if ((wall != value) && (hole != value))
+  {
+    throw std::invalid_argument("The input can only contain 0 or 1.");
+  }
+  else if (value == area(y, x))
+  {
+    changed = 0u;
+  }
+  else if (hole == value)
+  {
+    area(y, x) = hole;
+    opened(y, x);
+  }
+  else
+  {
+    area(y, x) = wall;
+    closed(y, x);
+  }
+}
+
+/**
+ * @brief   Returns the value of a cell.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Wall (0) or hole (1).
+ */
+uint8_t maze::incremental_solver::get_cell(uint32_t y, uint32_t x) const
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  return area(y, x);
+}
+
+/**
+ * @brief   Moves the entrance. Every distance changes, so it is a whole new search.
+ * @param   y - Y coordinate of the entrance.
+ * @param   x - X coordinate of the entrance.
+ * @return  void
+ */
+void maze::incremental_solver::set_entrance(uint32_t y, uint32_t x)
+{
+  solver search;
+  search.distance_field(area, y, x, field);
+  entrance_y = y;
+  entrance_x = x;
+  changed = static_cast<uint64_t>(height)*width;
+}
+
+/**
+ * @brief   Moves the exit. The distances don't depend on it, so nothing has to be repaired.
+ *          Like the entrance, it has to be a hole in the maze.
+ * @param   y - Y coordinate of the exit.
+ * @param   x - X coordinate of the exit.
+ * @return  void
+ */
+void maze::incremental_solver::set_exit(uint32_t y, uint32_t x)
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+
+  if (hole != area(y, x))
+  {
+    throw std::invalid_argument("The entrance and exit must be holes (1).");
+  }
+
+  exit_y = y;
+  exit_x = x;
+}
+
+/**
+ * @brief   Returns the length of the shortest path between the entrance and a cell.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  Number of steps, or unreached.
+ */
+uint32_t maze::incremental_solver::distance(uint32_t y, uint32_t x) const
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  return field[static_cast<size_t>(y)*width+x];
+}
+
+/**
+ * @brief   Returns the solution of the maze as it is now. It walks from the exit to a neighbour, that is one step closer, until the entrance.
+ * @param   route - The solution from the entrance, not found if the exit can't be reached.
+ * @return  void
+ */
+void maze::incremental_solver::path(direction_path &route) const
+{
+  uint32_t steps = distance(exit_y, exit_x);
+  route.clear();
+  if (unreached == steps)
+  {
+    return;
+  }
+
+  /* The walk goes backwards, so the steps are filled from the end, and every step is the opposite of the move. */
+  route.reset(entrance_y, entrance_x, steps);
+  uint32_t y = exit_y;
+  uint32_t x = exit_x;
+  for (uint32_t i = steps; i > 0u; i--)
+  {
+    uint32_t closer = i-1u;
+    size_t here = static_cast<size_t>(y)*width+x;
+    if ((y > 0u) && (closer == field[here-width]))
+    {
+      y--;
+      route.set_step(closer, direction_path::south);
+    }
+    else if (((y+1u) < height) && (closer == field[here+width]))
+    {
+      y++;
+      route.set_step(closer, direction_path::north);
+    }
+    else if ((x > 0u) && (closer == field[here-1u]))
+    {
+      x--;
+      route.set_step(closer, direction_path::east);
+    }
+    else
+    {
+      x++;
+      route.set_step(closer, direction_path::west);
+    }
+  }
+}
+
+/**
+ * @brief   Returns the maze with every change.
+ * @param   void
+ * @return  The maze.
+ */
+const maze::grid &maze::incremental_solver::get_maze(void) const
+{
+  return area;
+}
+
+/**
+ * @brief   Returns how many distances the last change has repaired. It shows how much work the change was.
+ * @param   void
+ * @return  Number of cells.
+ */
+uint64_t maze::incremental_solver::get_changed(void) const
+{
+  return changed;
+}
+
+/**
+ * @brief   Returns the height of the maze.
+ * @param   void
+ * @return  Height.
+ */
+uint32_t maze::incremental_solver::get_height(void) const
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the maze.
+ * @param   void
+ * @return  Width.
+ */
+uint32_t maze::incremental_solver::get_width(void) const
+{
+  return width;
+}
+
+/**
+ * @brief   Repairs the distances after a cell has been opened. Paths can only get shorter, and every shorter one goes through the cell.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  void
+ */
+void maze::incremental_solver::opened(uint32_t y, uint32_t x)
+{
+  size_t cell = static_cast<size_t>(y)*width+x;
+  size_t around[4u];
+  uint32_t count = neighbours(cell, around);
+  changed = 0u;
+
+  uint32_t best = unreached;
+  if ((y == entrance_y) && (x == entrance_x))
+  {
+    best = 0u;
+  }
+  else
+  {
+    for (uint32_t i = 0u; i < count; i++)
+    {
+      if (unreached != field[around[i]])
+      {
+        best = std::min(best, field[around[i]]+1u);
+      }
+    }
+  }
+  if (unreached == best)
+  {
+    return;
+  }
+
+  /* Breadth-first walk from the cell, but only through the cells, that get closer. */
+  field[cell] = best;
+  front.clear();
+  front.push(cell);
+  while (!front.empty())
+  {
+    cell = front.pop();
+    changed++;
+    count = neighbours(cell, around);
+    for (uint32_t i = 0u; i < count; i++)
+    {
+      if ((field[cell]+1u) < field[around[i]])
+      {
+        field[around[i]] = field[cell]+1u;
+        front.push(around[i]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief   Repairs the distances after a cell has been closed. Paths can only get longer, and only the ones, that went through the cell.
+ * @param   y - Y coordinate of the cell.
+ * @param   x - X coordinate of the cell.
+ * @return  void
+ */
+void maze::incremental_solver::closed(uint32_t y, uint32_t x)
+{
+  size_t cell = static_cast<size_t>(y)*width+x;
+  size_t around[4u];
+  changed = 0u;
+  if (unreached == field[cell])
+  {
+    return;
+  }
+
+  /* Collect the cells, that have lost every neighbour one step closer. It goes from the closed cell one distance at a time, */
+  /* so a neighbour is always decided after every cell, that is one step closer to the entrance. */
+  region.clear();
+  region.push_back(cell);
+  affected[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
+  for (size_t i = 0u; i < region.size(); i++)
+  {
+    size_t parent = region[i];
+    uint32_t count = neighbours(parent, around);
+    for (uint32_t j = 0u; j < count; j++)
+    {
+      size_t child = around[j];
+      if (((field[parent]+1u) != field[child]) || is_affected(child))
+      {
+        continue;
+      }
+      size_t others[4u];
+      uint32_t other_count = neighbours(child, others);
+      bool supported = false;
+      for (uint32_t k = 0u; (k < other_count) && (!supported); k++)
+      {
+        supported = ((field[others[k]]+1u) == field[child]) && (!is_affected(others[k]));
+      }
+      if (!supported)
+      {
+        region.push_back(child);
+        affected[child/64u] |= static_cast<uint64_t>(1u) << (child%64u);
+      }
+    }
+  }
+
+  /* Every collected cell starts from its closest neighbour outside of the region, if it has any. */
+  for (size_t member : region)
+  {
+    field[member] = unreached;
+  }
+  seeds.clear();
+  for (size_t member : region)
+  {
+    uint32_t count = neighbours(member, around);
+    uint32_t best = unreached;
+    for (uint32_t j = 0u; j < count; j++)
+    {
+      if ((!is_affected(around[j])) && (unreached != field[around[j]]))
+      {
+        best = std::min(best, field[around[j]]+1u);
+      }
+    }
+    if ((hole == area(static_cast<uint32_t>(member/width), static_cast<uint32_t>(member%width))) && (unreached != best))
+    {
+      seeds.push_back(seed{best, member});
+    }
+  }
+  std::sort(seeds.begin(), seeds.end(), [](const seed &first, const seed &second) { return first.steps < second.steps; });
+
+  /* Breadth-first walk inside the region, one distance at a time. The seeds join the walk at their own distance. */
+  size_t taken = 0u;
+  uint32_t level = 0u;
+  current.clear();
+  while ((taken < seeds.size()) || (!current.empty()))
+  {
+    if (current.empty())
+    {
+      level = seeds[taken].steps;
+    }
+    while ((taken < seeds.size()) && (level == seeds[taken].steps))
+    {
+      if (level < field[seeds[taken].cell])
+      {
+        field[seeds[taken].cell] = level;
+        current.push_back(seeds[taken].cell);
+      }
+      taken++;
+    }
+
+    next.clear();
+    for (size_t member : current)
+    {
+      uint32_t count = neighbours(member, around);
+      for (uint32_t j = 0u; j < count; j++)
+      {
+        if (is_affected(around[j]) && ((level+1u) < field[around[j]]))
+        {
+          field[around[j]] = level+1u;
+          next.push_back(around[j]);
+        }
+      }
+    }
+    current.swap(next);
+    level++;
+  }
+
+  for (size_t member : region)
+  {
+    affected[member/64u] &= ~(static_cast<uint64_t>(1u) << (member%64u));
+  }
+  changed = region.size();
+}
+
+/**
+ * @brief   Checks whether a cell has been collected for repairing.
+ * @param   cell - The cell.
+ * @return  True if it has been collected.
+ */
+bool maze::incremental_solver::is_affected(size_t cell) const
+{
+  return (affected[cell/64u] >> (cell%64u)) & 1u;
+}
+
+/**
+ * @brief   Collects the neighbours of a cell, that are holes.
+ * @param   cell    - The cell.
+ * @param   around  - The neighbours.
+ * @return  Number of neighbours.
+ */
+uint32_t maze::incremental_solver::neighbours(size_t cell, size_t (&around)[4u]) const
+{
+  uint32_t y = static_cast<uint32_t>(cell/width);
+  uint32_t x = static_cast<uint32_t>(cell%width);
+  uint32_t count = 0u;
+  if ((y > 0u) && (hole == area(y-1u, x)))
+  {
+    around[count++] = cell-width;
+  }
+  if (((y+1u) < height) && (hole == area(y+1u, x)))
+  {
+    around[count++] = cell+width;
+  }
+  if ((x > 0u) && (hole == area(y, x-1u)))
+  {
+    around[count++] = cell-1u;
+  }
+  if (((x+1u) < width) && (hole == area(y, x+1u)))
+  {
+    around[count++] = cell+1u;
+  }
+  return count;
+}
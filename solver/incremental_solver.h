@@ -0,0 +1,83 @@
+/**
+ * @file    incremental_solver.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Keeps a maze solved, while its cells are opened and closed one by one.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef INCREMENTAL_SOLVER_H_
+#define INCREMENTAL_SOLVER_H_
+
+#include <vector>
+#include <stdexcept>
+#include "solver.h"
+#include "direction_path.h"
+
+namespace maze
+{
+  /**
+   * The distance of every cell from the entrance is found once. After that every change of a cell only repairs
+   * the distances, that it changes:
+   * - Opening a cell can only shorten paths: a breadth-first walk goes out from it, only through the cells that get closer.
+   * - Closing a cell can only make paths longer: first the cells are collected, that have no other neighbour one step
+   *   closer to the entrance (their shortest paths all went through the closed cell), then only these cells are searched again,
+   *   starting from their unchanged neighbours.
+   * The solution is a walk down the distances from the exit, so it is available after every change.
+   */
+  class incremental_solver
+  {
+    public:
+      static constexpr uint32_t unreached = solver::unreached;
+
+      explicit incremental_solver(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+
+      void set_cell(uint32_t y, uint32_t x, uint32_t value);
+      uint8_t get_cell(uint32_t y, uint32_t x) const;
+      void set_entrance(uint32_t y, uint32_t x);
+      void set_exit(uint32_t y, uint32_t x);
+
+      uint32_t distance(uint32_t y, uint32_t x) const;
+      void path(direction_path &route) const;
+
+      const grid &get_maze(void) const;
+      uint64_t get_changed(void) const;
+      uint32_t get_height(void) const;
+      uint32_t get_width(void) const;
+
+    private:
+      static constexpr uint8_t wall = maze_generator::wall;
+      static constexpr uint8_t hole = maze_generator::hole;
+
+      /* A cell and its distance, where the search of the changed cells starts. */
+      struct seed {
+        uint32_t steps;
+        size_t cell;
+      };
+
+      grid area;
+      uint32_t height;
+      uint32_t width;
+      uint32_t entrance_y;
+      uint32_t entrance_x;
+      uint32_t exit_y;
+      uint32_t exit_x;
+      uint64_t changed;                  /**< Number of cells, whose distance the last change has repaired. */
+
+      std::vector<uint32_t> field;       /**< Distance of every cell from the entrance, unreached for walls and unconnected cells. */
+      std::vector<uint64_t> affected;    /**< One bit per cell, only set while a closed cell is repaired. */
+      std::vector<size_t> region;
+      std::vector<seed> seeds;
+      std::vector<size_t> current;
+      std::vector<size_t> next;
+      ring_queue<size_t> front;
+
+      void opened(uint32_t y, uint32_t x);
+      void closed(uint32_t y, uint32_t x);
+      bool is_affected(size_t cell) const;
+      uint32_t neighbours(size_t cell, size_t (&around)[4u]) const;
+  };
+}
+
+#endif /* INCREMENTAL_SOLVER_H_ */
@@ -0,0 +1,345 @@
+/**
+ * @file    junction_graph.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Graph of the junctions and dead ends of a maze, the corridors between them are weighted edges.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "junction_graph.h"
+
+/**
+ * @brief   Constructor. Finds the nodes, then walks every corridor from its nodes.
+ *          The maze doesn't have to be perfect, loops and unconnected parts are fine too.
+ * @param   vect - View of the maze. It isn't changed and isn't needed after the constructor.
+ * @return  void
+ */
+maze::junction_graph::junction_graph(grid_view vect) : height(vect.get_height()), width(vect.get_width())
+{
+  size_t cells = static_cast<size_t>(height)*width;
+  /* Every cell is stored as y*width+x, and the top bit marks the nodes. */
+  if (cells >= node_flag)
+  {
+    throw std::invalid_argument("The maze is too big for the graph.");
+  }
+  place.assign(cells, static_cast<uint32_t>(none));
+
+  static constexpr int32_t step_y[4u] = {-1, 1, 0, 0};
+  static constexpr int32_t step_x[4u] = {0, 0, -1, 1};
+
+  /* Going out of the maze wraps around to a too big coordinate. */
+  auto open = [&](uint32_t y, uint32_t x, uint8_t direction)
+  {
+    uint32_t next_y = y+step_y[direction];
+    uint32_t next_x = x+step_x[direction];
+    return (next_y < height) && (next_x < width) && (wall != vect(next_y, next_x));
+  };
+
+  /* Walks from a node in a direction, until the next node, and saves the corridor as an edge. */
+  auto walk = [&](uint32_t start, uint8_t direction)
+  {
+    uint32_t y = node_at[start].y+step_y[direction];
+    uint32_t x = node_at[start].x+step_x[direction];
+    uint32_t next = y*width+x;
+
+    if ((none != place[next]) && (place[next] & node_flag))
+    {
+      /* Two nodes next to each other. The edge is only saved from the smaller one. */
+      if (start < (place[next] & ~node_flag))
+      {
+        edges.push_back({start, place[next] & ~node_flag, 1u, static_cast<uint32_t>(corridor.size())});
+      }
+      return;
+    }
+    if (none != place[next])
+    {
+      /* This corridor has been walked from its other end. */
+      return;
+    }
+
+    uint32_t offset = static_cast<uint32_t>(corridor.size());
+    uint32_t weight = 1u;
+    while (none == place[next])
+    {
+      place[next] = static_cast<uint32_t>(corridor.size());
+      corridor.push_back(next);
+      weight++;
+
+      /* A corridor has two open neighbours, go to the one, that it didn't come from. */
+      uint8_t came_from = direction ^ 1u;
+      for (uint8_t i = 0u; i < 4u; i++)
+      {
+        if ((i != came_from) && open(y, x, i))
+        {
+          direction = i;
+          break;
+        }
+      }
+      y += step_y[direction];
+      x += step_x[direction];
+      next = y*width+x;
+    }
+    edges.push_back({start, place[next] & ~node_flag, weight, offset});
+  };
+
+  /* Every open cell, that isn't a corridor, is a node. */
+  for (uint32_t y = 0u; y < height; y++)
+  {
+    for (uint32_t x = 0u; x < width; x++)
+    {
+      if (wall == vect(y, x))
+      {
+        continue;
+      }
+      uint32_t neighbours = 0u;
+      for (uint8_t i = 0u; i < 4u; i++)
+      {
+        neighbours += open(y, x, i);
+      }
+      if (2u != neighbours)
+      {
+        place[y*width+x] = static_cast<uint32_t>(node_at.size()) | node_flag;
+        node_at.push_back({y, x});
+      }
+    }
+  }
+
+  for (uint32_t node = 0u; node < node_at.size(); node++)
+  {
+    for (uint8_t i = 0u; i < 4u; i++)
+    {
+      if (open(node_at[node].y, node_at[node].x, i))
+      {
+        walk(node, i);
+      }
+    }
+  }
+
+  /* The corridors left are loops without any node. One cell of each becomes a node, and the loop is an edge to itself. */
+  for (uint32_t y = 0u; y < height; y++)
+  {
+    for (uint32_t x = 0u; x < width; x++)
+    {
+      if ((wall != vect(y, x)) && (none == place[y*width+x]))
+      {
+        uint32_t node = static_cast<uint32_t>(node_at.size());
+        place[y*width+x] = node | node_flag;
+        node_at.push_back({y, x});
+        uint8_t direction = 0u;
+        while (!open(y, x, direction))
+        {
+          direction++;
+        }
+        walk(node, direction);
+      }
+    }
+  }
+
+  /* The neighbours of every node next to each other. An edge to itself is never needed for a search. */
+  first_link.assign(node_at.size()+1u, 0u);
+  for (const edge &current : edges)
+  {
+    longest = std::max(longest, current.weight);
+    if (current.start != current.end)
+    {
+      first_link[current.start+1u]++;
+      first_link[current.end+1u]++;
+    }
+  }
+  for (size_t i = 1u; i < first_link.size(); i++)
+  {
+    first_link[i] += first_link[i-1u];
+  }
+  links.resize(first_link.back());
+  std::vector<uint32_t> next_link(first_link.begin(), first_link.end()-1u);
+  for (uint32_t i = 0u; i < edges.size(); i++)
+  {
+    if (edges[i].start != edges[i].end)
+    {
+      links[next_link[edges[i].start]++] = {edges[i].end, i*2u, edges[i].weight};
+      links[next_link[edges[i].end]++] = {edges[i].start, i*2u+1u, edges[i].weight};
+    }
+  }
+}
+
+/**
+ * @brief   Finds the nodes, that can be reached from a cell directly. A node only reaches itself,
+ *          a corridor cell reaches the two ends of its corridor.
+ * @param   y       - Y coordinate of the cell.
+ * @param   x       - X coordinate of the cell.
+ * @param   &found  - The nodes. For a corridor cell the first one is the start of the edge, the second one is the end.
+ * @return  Number of nodes (1 or 2).
+ */
+uint32_t maze::junction_graph::anchors(uint32_t y, uint32_t x, anchor (&found)[2]) const
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  uint32_t position = place[y*width+x];
+  if (none == position)
+  {
+    throw std::invalid_argument("The entrance and exit can't be walls.");
+  }
+  if (position & node_flag)
+  {
+    found[0u] = {position & ~node_flag, none, 0u};
+    return 1u;
+  }
+
+  uint32_t index = edge_of(position);
+  uint32_t step = position-edges[index].offset+1u;
+  found[0u] = {edges[index].start, index*2u+1u, step};
+  found[1u] = {edges[index].end, index*2u, edges[index].weight-step};
+  return 2u;
+}
+
+/**
+ * @brief   Lists the cells of a path found on the graph. It takes as many steps, as long the path is.
+ * @param   &path   - The path.
+ * @param   &route  - Every [y,x] of the path from the entrance to the exit. Empty if there is no path.
+ * @return  void
+ */
+void maze::junction_graph::expand(const junction_path &path, std::vector<solver::coordinate> &route) const
+{
+  route.clear();
+  if (!path.found)
+  {
+    return;
+  }
+  route.reserve(path.length+1u);
+  route.push_back({path.entrance_y, path.entrance_x});
+
+  for (size_t i = 0u; i < path.hops.size(); i++)
+  {
+    const edge &current = edges[path.hops[i] >> 1u];
+    bool backwards = path.hops[i] & 1u;
+    uint32_t from = backwards ? current.weight : 0u;
+    uint32_t to = backwards ? 0u : current.weight;
+
+    /* The first and the last edge can be walked partly, if the entrance or the exit is inside the corridor. */
+    uint32_t position = place[path.entrance_y*width+path.entrance_x];
+    if ((0u == i) && (!(position & node_flag)))
+    {
+      from = position-current.offset+1u;
+    }
+    position = place[path.exit_y*width+path.exit_x];
+    if (((path.hops.size()-1u) == i) && (!(position & node_flag)))
+    {
+      to = position-current.offset+1u;
+    }
+
+    while (from != to)
+    {
+      from = backwards ? (from-1u) : (from+1u);
+      route.push_back(cell_of(current, from));
+    }
+  }
+}
+
+/**
+ * @brief   Returns the y coordinate of a node.
+ * @param   node - The node.
+ * @return  y
+ */
+uint32_t maze::junction_graph::get_y(uint32_t node) const
+{
+  return node_at[node].y;
+}
+
+/**
+ * @brief   Returns the x coordinate of a node.
+ * @param   node - The node.
+ * @return  x
+ */
+uint32_t maze::junction_graph::get_x(uint32_t node) const
+{
+  return node_at[node].x;
+}
+
+/**
+ * @brief   Returns the number of nodes.
+ * @param   void
+ * @return  nodes
+ */
+uint32_t maze::junction_graph::get_nodes(void) const
+{
+  return static_cast<uint32_t>(node_at.size());
+}
+
+/**
+ * @brief   Returns the number of edges.
+ * @param   void
+ * @return  edges
+ */
+uint32_t maze::junction_graph::get_edges(void) const
+{
+  return static_cast<uint32_t>(edges.size());
+}
+
+/**
+ * @brief   Returns the weight of the longest edge.
+ * @param   void
+ * @return  longest
+ */
+uint32_t maze::junction_graph::get_longest(void) const
+{
+  return longest;
+}
+
+/**
+ * @brief   Returns the height of the maze.
+ * @param   void
+ * @return  height
+ */
+uint32_t maze::junction_graph::get_height(void) const
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the maze.
+ * @param   void
+ * @return  width
+ */
+uint32_t maze::junction_graph::get_width(void) const
+{
+  return width;
+}
+
+/**
+ * @brief   Finds the edge of a corridor cell. The edges are saved in the order of their offsets.
+ * @param   position - Position of the cell in the corridor array.
+ * @return  The edge.
+ */
+uint32_t maze::junction_graph::edge_of(uint32_t position) const
+{
+  auto after = std::upper_bound(edges.begin(), edges.end(), position, [](uint32_t value, const edge &current)
+  {
+    return value < current.offset;
+  });
+  return static_cast<uint32_t>(after-edges.begin())-1u;
+}
+
+/**
+ * @brief   Returns a cell of an edge.
+ * @param   &current  - The edge.
+ * @param   step      - Steps from the start: 0 is the start node, weight is the end node.
+ * @return  [y,x] of the cell.
+ */
+maze::solver::coordinate maze::junction_graph::cell_of(const edge &current, uint32_t step) const
+{
+  if (0u == step)
+  {
+    return node_at[current.start];
+  }
+  else if (current.weight == step)
+  {
+    return node_at[current.end];
+  }
+  else
+  {
+    return {corridor[current.offset+step-1u]/width, corridor[current.offset+step-1u]%width};
+  }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file    junction_graph.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Graph of the junctions and dead ends of a maze, the corridors between them are weighted edges.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef JUNCTION_GRAPH_H_
+#define JUNCTION_GRAPH_H_
+
+#include <vector>
+#include <stdexcept>
+#include "solver.h"
+
+namespace maze
+{
+  /* A solution found on a junction graph: the edges it goes through. The cells are only listed by junction_graph::expand(). */
+  struct junction_path {
+    uint32_t entrance_y;
+    uint32_t entrance_x;
+    uint32_t exit_y;
+    uint32_t exit_x;
+    bool found;
+    uint64_t length;              /**< Number of steps. */
+    std::vector<uint32_t> hops;   /**< Edges from the entrance to the exit: edge*2, plus one if it is walked backwards. */
+  };
+
+  /**
+   * Most cells of a maze are corridors: they have exactly two open neighbours, there is no decision to make there.
+   * Every other open cell (junction, dead end) is a node, and every corridor between two nodes is a single edge,
+   * weighted with its length. The cells of the corridors are stored in one flat array, every edge has an offset into it.
+   * The graph is built once, then it can be searched many times (solver::dijkstra(), solver::astar()).
+   */
+  class junction_graph
+  {
+    public:
+      /* A neighbour of a node. */
+      struct link {
+        uint32_t node;
+        uint32_t hop;
+        uint32_t weight;
+      };
+
+      /* A node, that can be reached from a cell directly, without going through any other node. */
+      struct anchor {
+        uint32_t node;
+        uint32_t hop;     /**< From the cell to the node, none if the cell is the node itself. */
+        uint32_t length;
+      };
+
+      static constexpr uint32_t none = UINT32_MAX;
+
+      explicit junction_graph(grid_view vect);
+
+      uint32_t anchors(uint32_t y, uint32_t x, anchor (&found)[2]) const;
+      void expand(const junction_path &path, std::vector<solver::coordinate> &route) const;
+
+      /**
+       * @brief   Returns the neighbours of a node.
+       * @param   node - The node.
+       * @return  Pointer to the first neighbour, the last one is before links_end(node).
+       */
+      const link *links_begin(uint32_t node) const { return links.data()+first_link[node]; }
+      const link *links_end(uint32_t node) const { return links.data()+first_link[node+1u]; }
+
+      uint32_t get_y(uint32_t node) const;
+      uint32_t get_x(uint32_t node) const;
+      uint32_t get_nodes(void) const;
+      uint32_t get_edges(void) const;
+      uint32_t get_longest(void) const;
+      uint32_t get_height(void) const;
+      uint32_t get_width(void) const;
+
+    private:
+      static constexpr uint8_t wall = maze_generator::wall;
+      static constexpr uint32_t node_flag = 0x80000000u;
+
+      /* A corridor. Its cells are corridor[offset] ... corridor[offset+weight-2], from start to end. */
+      struct edge {
+        uint32_t start;
+        uint32_t end;
+        uint32_t weight;
+        uint32_t offset;
+      };
+
+      uint32_t height;
+      uint32_t width;
+
+      std::vector<uint32_t> place;        /**< Every cell: node|node_flag, position in the corridor array or none for walls. */
+      std::vector<solver::coordinate> node_at;
+      std::vector<uint32_t> corridor;     /**< y*width+x of every corridor cell, grouped by edges. */
+      std::vector<edge> edges;
+      std::vector<uint32_t> first_link;   /**< The neighbours of a node are links[first_link[node]] ... links[first_link[node+1]-1]. */
+      std::vector<link> links;
+      uint32_t longest = 0u;              /**< Weight of the longest edge. */
+
+      uint32_t edge_of(uint32_t position) const;
+      solver::coordinate cell_of(const edge &current, uint32_t step) const;
+  };
+}
+
+#endif /* JUNCTION_GRAPH_H_ */
@@ -0,0 +1,78 @@
+/**
+ * @file    ring_queue.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   First-in first-out queue on a ring buffer, for the solvers.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef RING_QUEUE_H_
+#define RING_QUEUE_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace maze
+{
+  /**
+   * The elements are never moved, only the head and the tail go around the buffer.
+   * The capacity is a power of two, so going around is a mask, not a division.
+   * It is set up front; if it is still too small, it doubles.
+   */
+  template <typename element>
+  class ring_queue
+  {
+    public:
+      explicit ring_queue(size_t capacity = 64u)
+      {
+        size_t size = 1u;
+        while (size < capacity)
+        {
+          size <<= 1u;
+        }
+        buffer.resize(size);
+      }
+
+      bool empty(void) const { return head == tail; }
+      size_t size(void) const { return tail-head; }
+      void clear(void) { head = 0u; tail = 0u; }
+
+      void push(const element &value)
+      {
+        if (buffer.size() == size())
+        {
+          grow();
+        }
+        buffer[tail & (buffer.size()-1u)] = value;
+        tail++;
+      }
+
+      element pop(void)
+      {
+        element value = buffer[head & (buffer.size()-1u)];
+        head++;
+        return value;
+      }
+
+    private:
+      std::vector<element> buffer;
+      size_t head = 0u; /**< Only increases, the position in the buffer is masked out of it. */
+      size_t tail = 0u;
+
+      void grow(void)
+      {
+        std::vector<element> bigger(buffer.size()*2u);
+        for (size_t i = head; i < tail; i++)
+        {
+          bigger[i-head] = buffer[i & (buffer.size()-1u)];
+        }
+        tail -= head;
+        head = 0u;
+        buffer.swap(bigger);
+      }
+  };
+}
+
+#endif /* RING_QUEUE_H_ */
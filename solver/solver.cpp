@@ -8,85 +8,103 @@
  */ 
 
 #include "solver.h"
+#include "junction_graph.h"
+#include "cluster_graph.h"
+#include "task_pool.h"
+#include "bitplane_wave.h"
+#include "direction_path.h"
 
 /**
  * @brief   Solves the maze with dead-end filling algorithm.
- * @param   &vect - The vector-vector of the maze we want to solve. It overwrites the input one.
+ *          The dead-ends are collected with a single scan, then every corridor is followed from its dead-end
+ *          with a worklist, so every cell is only checked a few times, no matter how long the corridors are.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
  * @param   entrance_y  - Y coordinate of the entrance.
  * @param   entrance_x  - X coordinate of the entrance.
  * @param   exit_y      - Y coordinate of the exit.
  * @param   exit_x      - X coordinate of the exit.
  * @return  void
  */
-void maze::solver::dead_end(std::vector<std::vector<uint32_t>> &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+void maze::solver::dead_end(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
 {
   error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
 
   /* Separate the entrace and exit from everything. */
-  vect[entrance_y][entrance_x] = never_dead;
-  vect[exit_y][exit_x] = never_dead;
-  bool found_dead_end = true;
+  vect(entrance_y, entrance_x) = never_dead;
+  vect(exit_y, exit_x) = never_dead;
+  std::vector<distance> worklist;
 
-  /* Loop until there are dead-ends. */
-  while(found_dead_end)
-  { 
-    found_dead_end = false;
-    /* Loop through the maze. */
-    for(uint32_t y = 0u; y < vect.size(); y++)
+  /* A hole is a dead-end, if at most one of its neighbours is still open (not a wall and not a dead-end). */
+  /* The boundaries are dead-ends in every case. */
+  auto is_dead_end = [&](uint32_t y, uint32_t x) -> bool
+  {
+    if ((0u == y) || (0u == x) || (vect.get_height()-1u == y) || (vect.get_width()-1u == x))
+    {
+      return true;
+    }
+    uint32_t open_counter = 0u;
+    open_counter += ((wall != vect(y-1u, x)) && (dead != vect(y-1u, x))) ? 1u : 0u;
+    open_counter += ((wall != vect(y+1u, x)) && (dead != vect(y+1u, x))) ? 1u : 0u;
+    open_counter += ((wall != vect(y, x-1u)) && (dead != vect(y, x-1u))) ? 1u : 0u;
+    open_counter += ((wall != vect(y, x+1u)) && (dead != vect(y, x+1u))) ? 1u : 0u;
+    return (1u >= open_counter);
+  };
+
+  /* Collect every dead-end with a single scan. */
+  for(uint32_t y = 0u; y < vect.get_height(); y++)
+  {
+    for(uint32_t x = 0u; x < vect.get_width(); x++)
     {
-      for(uint32_t x = 0u; x < vect[y].size(); x++)
+      if ((hole == vect(y, x)) && is_dead_end(y, x))
       {
-        uint32_t dead_end_counter = 0u;
+        worklist.push_back({y, x});
+      }
+    }
+  }
 
-        if (hole == vect[y][x])
-        {
-          /* Check the 4 directions of the hole. */
-          /* North. */
-          if ((y > 0u) && ((wall == vect[y-1u][x]) || (dead == vect[y-1u][x])))
-          {
-            dead_end_counter++;
-          }
-          /* South. */
-          if (((y+1u) < vect.size()) && ((wall == vect[y+1u][x]) || (dead == vect[y+1u][x])))
-          {
-            dead_end_counter++;
-          }
-          /* West. */
-          if ((x > 0u) && ((wall == vect[y][x-1u]) || (dead == vect[y][x-1u])))
-          {
-            dead_end_counter++;
-          }
-          /* East. */
-          if (((x+1u) < vect[0u].size()) && ((wall == vect[y][x+1u]) || (dead == vect[y][x+1u])))
-          {
-            dead_end_counter++;
-          }
+  /* Fill the dead-ends. Only the neighbours of a filled cell can become new dead-ends, so only they are checked. */
+  while (!worklist.empty())
+  {
+    uint32_t y = worklist.back().y;
+    uint32_t x = worklist.back().x;
+    worklist.pop_back();
 
-          /* If a hole has 3 walls (or dead-ends) next to it, then it is a dead-end. */
-          /* The boundaries are dead-ends in every case. */
-          if ((3u == dead_end_counter) \
-          || ((0u == y) || (0u == x) || (vect.size()-1u == y) || (vect[0u].size()-1u == x)))
-          {
-            vect[y][x] = dead;
-            found_dead_end = true;
-          }
-        }
-      }
+    if (hole != vect(y, x))
+    {
+      continue;
+    }
+    vect(y, x) = dead;
+
+    if ((y > 0u) && (hole == vect(y-1u, x)) && is_dead_end(y-1u, x))
+    {
+      worklist.push_back({y-1u, x});
+    }
+    if (((y+1u) < vect.get_height()) && (hole == vect(y+1u, x)) && is_dead_end(y+1u, x))
+    {
+      worklist.push_back({y+1u, x});
+    }
+    if ((x > 0u) && (hole == vect(y, x-1u)) && is_dead_end(y, x-1u))
+    {
+      worklist.push_back({y, x-1u});
+    }
+    if (((x+1u) < vect.get_width()) && (hole == vect(y, x+1u)) && is_dead_end(y, x+1u))
+    {
+      worklist.push_back({y, x+1u});
     }
   }
 
   /* Clean-up. Turn every hole (+ the separted entrance and exit) into a solution and turn back every dead-end into a hole. */
-  for(uint32_t y = 0u; y < vect.size(); y++)
+  for(uint32_t y = 0u; y < vect.get_height(); y++)
   {
-    for(uint32_t x = 0u; x < vect[y].size(); x++)
+    for(uint32_t x = 0u; x < vect.get_width(); x++)
     {
-      if ((hole == vect[y][x]) || (never_dead == vect[y][x]))
+      if ((hole == vect(y, x)) || (never_dead == vect(y, x)))
       {
-        vect[y][x] = solution;
+        vect(y, x) = solution;
       }
-      else if (dead == vect[y][x])
+      else if (dead == vect(y, x))
       {
-        vect[y][x] = hole;
+        vect(y, x) = hole;
       }
       else
       {
@@ -98,124 +116,292 @@ void maze::solver::dead_end(std::vector<std::vector<uint32_t>> &vect, uint32_t e
 }
 
 /**
- * @brief   Solves the maze with Dijstra's algorithm.
- * @param   &vect       - The vector-vector of the maze we want to solve. It overwrites the input one.
+ * @brief   Solves the maze with Dijstra's algorithm. Every step costs the same, so it is a breadth-first walk.
+ *          The front of the walk is in a ring buffer and every reached cell saves the direction back (2 bits),
+ *          so the way back needs no searching and the maze itself is only changed on the solution.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::dijkstra(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint8_t> back;
+  if (breadth_first(vect, entrance_y, entrance_x, exit_y, exit_x, back))
+  {
+    /* Only the solution is written into the maze, so there is nothing to clean up afterwards. */
+    trace_back(vect, back, entrance_y, entrance_x, exit_y, exit_x);
+  }
+}
+
+/**
+ * @brief   Solves the maze with Dijstra's algorithm, like dijkstra() above, but the maze isn't changed:
+ *          the solution is returned as a list of directions.
+ * @param   vect        - View of the maze we want to solve.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
+ * @return  void
+ */
+void maze::solver::dijkstra(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint8_t> back;
+  path.clear();
+  if (breadth_first(vect, entrance_y, entrance_x, exit_y, exit_x, back))
+  {
+    trace_path(vect.get_width(), back, entrance_y, entrance_x, exit_y, exit_x, path);
+  }
+}
+
+/**
+ * @brief   Solves the maze with A* algorithm. It prefers the cells closer to the exit (Manhattan distance),
+ *          so in mazes with loops and rooms it reaches far fewer cells, than Dijkstra's algorithm.
+ *          Every step costs the same, so the priorities are small integers and they are kept in buckets.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::astar(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint8_t> back;
+  if (best_first(vect, entrance_y, entrance_x, exit_y, exit_x, back))
+  {
+    trace_back(vect, back, entrance_y, entrance_x, exit_y, exit_x);
+  }
+}
+
+/**
+ * @brief   Solves the maze with A* algorithm, like astar() above, but the maze isn't changed:
+ *          the solution is returned as a list of directions.
+ * @param   vect        - View of the maze we want to solve.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
+ * @return  void
+ */
+void maze::solver::astar(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint8_t> back;
+  path.clear();
+  if (best_first(vect, entrance_y, entrance_x, exit_y, exit_x, back))
+  {
+    trace_path(vect.get_width(), back, entrance_y, entrance_x, exit_y, exit_x, path);
+  }
+}
+
+/**
+ * @brief   Solves a maze, where the cells have different costs (terrain), with Dijkstra's algorithm. It finds the cheapest solution, not the shortest one.
+ *          The costs are small integers, so the queue is a circle of buckets (Dial's algorithm): no comparison, and the cells never move.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   costs       - View of the cost of stepping into every cell (1-255), 0 can't be entered. The same size as the maze.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::weighted(grid_view vect, grid_view costs, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint8_t> back;
+  if (cheapest_first(vect, costs, entrance_y, entrance_x, exit_y, exit_x, back))
+  {
+    trace_back(vect, back, entrance_y, entrance_x, exit_y, exit_x);
+  }
+}
+
+/**
+ * @brief   Solves a maze with terrain, like weighted() above, but the maze isn't changed: the solution is returned as a list of directions.
+ * @param   vect        - View of the maze we want to solve.
+ * @param   costs       - View of the cost of stepping into every cell (1-255), 0 can't be entered. The same size as the maze.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
+ * @return  void
+ */
+void maze::solver::weighted(grid_view vect, grid_view costs, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint8_t> back;
+  path.clear();
+  if (cheapest_first(vect, costs, entrance_y, entrance_x, exit_y, exit_x, back))
+  {
+    trace_path(vect.get_width(), back, entrance_y, entrance_x, exit_y, exit_x, path);
+  }
+}
+
+/**
+ * @brief   Solves the maze with a breadth-first walk from both the entrance and the exit, until they meet.
+ *          Always the side with the shorter front takes the next step, so together they reach fewer cells, than Dijkstra's algorithm.
+ *          A whole step is taken at once, so the first meeting is on a shortest solution.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::bidirectional(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  direction_path path;
+  bidirectional(vect, entrance_y, entrance_x, exit_y, exit_x, path);
+  path.stamp(vect, solution);
+}
+
+/**
+ * @brief   Solves the maze like bidirectional() above, but the maze isn't changed: the solution is returned as a list of directions.
+ * @param   vect        - View of the maze we want to solve.
  * @param   entrance_y  - Y coordinate of the entrance.
  * @param   entrance_x  - X coordinate of the entrance.
  * @param   exit_y      - Y coordinate of the exit.
  * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
  * @return  void
  */
-void maze::solver::dijkstra(std::vector<std::vector<uint32_t>> &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+void maze::solver::bidirectional(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
 {
   error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
 
-  std::vector<distance> distances;
-  uint32_t distance_cnt = 3u; /* Should be 0, but 0-2 are already used, so it would confuse everything. */
-  distances.push_back({entrance_y, entrance_x}); 
-  bool new_distance = true;
-  uint32_t y = 0u;
-  uint32_t x = 0u;
+  path.clear();
+  size_t width = vect.get_width();
+  size_t cells = static_cast<size_t>(vect.get_height())*width;
+  /* One bit per cell for both sides (0: from the entrance, 1: from the exit), set when the side has reached the cell. */
+  std::vector<uint64_t> reached[2u];
+  reached[0u].assign((cells+63u)/64u, 0u);
+  reached[1u].assign((cells+63u)/64u, 0u);
+  /* Two bits per cell: the direction back towards the side, that has reached it. A cell is only reached by one side. */
+  std::vector<uint8_t> back((cells+3u)/4u, 0u);
+  std::vector<distance> front[2u];
+  std::vector<distance> next;
+  /* The two neighbouring cells, where the sides have met. */
+  distance meeting[2u] = {{entrance_y, entrance_x}, {entrance_y, entrance_x}};
+  bool found = ((entrance_y == exit_y) && (entrance_x == exit_x));
 
-  /* Walk away from the entrace and save their distance (from the entrance). */
-  while(new_distance)
+  size_t start = entrance_y*width+entrance_x;
+  size_t end = exit_y*width+exit_x;
+  reached[0u][start/64u] |= static_cast<uint64_t>(1u) << (start%64u);
+  reached[1u][end/64u] |= static_cast<uint64_t>(1u) << (end%64u);
+  front[0u].push_back({entrance_y, entrance_x});
+  front[1u].push_back({exit_y, exit_x});
+
+  while ((!found) && (!front[0u].empty()) && (!front[1u].empty()))
   {
-    new_distance = false;
-    uint32_t distance_max = distances.size();
-    distance_cnt++;
-    /* With the for loop, we can walk "parellel". */
-    /* If there are 2 path, then there'll 2 elements in the vector, if there are 3, then 3, etc..*/
-    for (uint32_t i = 0u; i < distance_max; i++)
+    uint32_t side = (front[0u].size() <= front[1u].size()) ? 0u : 1u;
+    uint64_t *own = reached[side].data();
+    const uint64_t *other = reached[side^1u].data();
+    uint8_t *directions = back.data();
+    next.clear();
+    for (size_t i = 0u; (i < front[side].size()) && (!found); i++)
     {
-      y = distances[0u].y;
-      x = distances[0u].x;
+      distance current = front[side][i];
 
-      vect[y][x] = distance_cnt;
-      /* if north is a hole, then save. */
-      if ((y > 0u) && (hole == vect[y-1u][x]))
+      /* Saves a neighbour into the next front, if it is a hole and this side hasn't reached it yet. */
+      /* If the other side has reached it already, then the two sides have met. */
+      auto reach = [&](uint32_t y, uint32_t x, uint8_t direction)
       {
-        distances.push_back({y-1u,x});
-        new_distance = true;
-      }
-      /* Ff south is a hole, then save. */
-      if (((y+1u) < vect.size()) && (hole == vect[y+1u][x]))
+        size_t cell = y*width+x;
+        if ((hole != vect(y, x)) || ((own[cell/64u] >> (cell%64u)) & 1u))
+        {
+          return;
+        }
+        if ((other[cell/64u] >> (cell%64u)) & 1u)
+        {
+          found = true;
+          meeting[side] = current;
+          meeting[side^1u] = {y, x};
+          return;
+        }
+        own[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
+        directions[cell/4u] |= static_cast<uint8_t>(direction << ((cell%4u)*2u));
+        next.push_back({y, x});
+      };
+
+      if (current.y > 0u)
       {
-        distances.push_back({y+1u,x});
-        new_distance = true;
+        reach(current.y-1u, current.x, south);
       }
-      /* if west is a hole, then save. */
-      if ((x > 0u) && (hole == vect[y][x-1u]))
+      if ((current.y+1u) < vect.get_height())
       {
-        distances.push_back({y,x-1u});
-        new_distance = true;
+        reach(current.y+1u, current.x, north);
       }
-      /* If east is a hole, then save. */
-      if (((x+1u) < vect[0u].size()) && (hole == vect[y][x+1u]))
+      if (current.x > 0u)
       {
-        distances.push_back({y,x+1u});
-        new_distance = true;
+        reach(current.y, current.x-1u, east);
       }
-      
-      /* Stop at the end. It could run and check every cell in the maze, but it would be waste of time. */
-      if ((y == exit_y) && (x == exit_x))
+      if ((current.x+1u) < vect.get_width())
       {
-        new_distance = false;
-        break;
+        reach(current.y, current.x+1u, west);
       }
-
-      distances.erase(distances.begin());
     }
+    front[side].swap(next);
+  }
+
+  if (!found)
+  {
+    return;
   }
 
-  /* Walk back from the exit to the entrance. */
-  y = exit_y;
-  x = exit_x;
-  distance_cnt = vect[y][x];
+  /* Both halves of the solution lead back to their own side. The half of the entrance is walked back like in dijkstra(). */
+  trace_path(width, back, entrance_y, entrance_x, meeting[0u].y, meeting[0u].x, path);
+  if ((meeting[0u].y == meeting[1u].y) && (meeting[0u].x == meeting[1u].x))
+  {
+    return;
+  }
 
-  /* Loop until we aren't at the beginning. */
-  while(3u != distance_cnt)
+  /* One step over the meeting, then the directions of the other half point forward, towards the exit. */
+  path.push(towards(meeting[0u].y, meeting[0u].x, meeting[1u].y, meeting[1u].x));
+  uint32_t y = meeting[1u].y;
+  uint32_t x = meeting[1u].x;
+  while ((y != exit_y) || (x != exit_x))
   {
-    /* Mark everything as a solution on the way. */
-    vect[y][x] = solution;
-    distance_cnt--;
-    if ((y > 0u) && (distance_cnt == vect[y-1u][x]))
+    size_t cell = y*width+x;
+    uint8_t direction = (back[cell/4u] >> ((cell%4u)*2u)) & 3u;
+    path.push(direction);
+    if (north == direction)
     {
       y--;
     }
-    else if (((y+1u) < vect.size()) && (distance_cnt == vect[y+1u][x]))
+    else if (south == direction)
     {
       y++;
     }
-    else if ((x > 0u) && (distance_cnt == vect[y][x-1u]))
+    else if (west == direction)
     {
       x--;
     }
-    else if (((x+1u) < vect[0u].size()) && (distance_cnt == vect[y][x+1u]))
-    {
-      x++;
-    }
     else
     {
-      /* Do nothing. */
-    }
-  }
-
-  /* Clean up, the output shall only contain walls, holes or solutions. */
-  for(uint32_t y = 0u; y < vect.size(); y++)
-  {
-    for(uint32_t x = 0u; x < vect[y].size(); x++)
-    {
-      if ((wall != vect[y][x]) && (solution != vect[y][x]))
-      {
-        vect[y][x] = hole;
-      }
+      x++;
     }
   }
 }
 
 /**
  * @brief   Solves the maze with wall follower algorithm.
- * @param   &vect       - The vector-vector of the maze we want to solve. It overwrites the input one.
+ *          The order of the directions to try comes from a table (hand rule, heading), a move is an offset in the maze,
+ *          and the path is a stack of 2-bit directions, so a step is only a few table lookups.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
  * @param   entrance_y  - Y coordinate of the entrance.
  * @param   entrance_x  - X coordinate of the entrance.
  * @param   exit_y      - Y coordinate of the exit.
@@ -223,189 +409,1385 @@ void maze::solver::dijkstra(std::vector<std::vector<uint32_t>> &vect, uint32_t e
  * @param   rule        - Which hand rule to use. Either left (0) or right (1). The defult value is left.
  * @return  void
  */
-void maze::solver::wall_follower(std::vector<std::vector<uint32_t>> &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, uint32_t rule)
+void maze::solver::wall_follower(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, uint32_t rule)
 {
   error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+  if ((left != rule) && (right != rule))
+  {
+    throw std::invalid_argument("The rule can only be left or right.");
+  }
+
+  /* The directions in priority order, for both rules and for every heading. */
+  static constexpr uint8_t priorities[2u][4u][4u] =
+  {
+    /* Left-hand rule: north, south, west and east heading. */
+    {{west, north, east, south}, {east, south, west, north}, {south, west, north, east}, {north, east, south, west}},
+    /* Right-hand rule: north, south, west and east heading. */
+    {{east, north, west, south}, {west, south, east, north}, {north, west, south, east}, {south, east, north, west}}
+  };
+  static constexpr int32_t step_y[4u] = {-1, 1, 0, 0};
+  static constexpr int32_t step_x[4u] = {0, 0, -1, 1};
+  const ptrdiff_t offsets[4u] = {-static_cast<ptrdiff_t>(vect.get_stride()), static_cast<ptrdiff_t>(vect.get_stride()), -1, 1};
 
   uint32_t y = entrance_y;
   uint32_t x = entrance_x;
-  uint32_t direction = north;
-  std::vector<uint32_t> directions(4);
-  std::vector<element> visited;
-  visited.push_back({y, x, 99u}); /* The first direction has to be invalid, so it never gets removed. */
-  vect[y][x] = solution;
+  uint8_t *cell = &vect(y, x);
+  uint8_t direction = north;
+  /* Every step of the path, 32 directions in every word. */
+  std::vector<uint64_t> path(1u, 0u);
+  uint64_t depth = 0u;
+  *cell = solution;
 
   /* Loop until we aren't at the end. */
   while(!((y == exit_y) && (x == exit_x)))
   {
-
-    /* Left-hand rule and its priorities. */
-    if (left == rule)
+    /* Try to move in every direction, in priority order, and go to the first possible one. */
+    /* If it goes back, then pop it from the path and remove the solution mark. */
+    /* Otherwise push it to the path and mark it as a solution. */
+    const uint8_t *order = priorities[rule][direction];
+    for (uint32_t i = 0u; i < 4u; i++)
     {
-      if (north == direction)
-      {
-        directions = {west, north, east, south};
-      }
-      else if (south == direction)
+      uint8_t next = order[i];
+      uint32_t next_y = y+step_y[next];
+      uint32_t next_x = x+step_x[next];
+      /* Going out of the maze wraps around to a too big coordinate. */
+      if ((next_y < vect.get_height()) && (next_x < vect.get_width()) && (wall != cell[offsets[next]]))
       {
-        directions = {east, south, west, north};
-      }
-      else if (west == direction)
-      {
-        directions = {south, west, north, east};
-      }
-      else if (east == direction)
-      {
-        directions = {north, east, south, west};
-      }
-      else
-      {
-        /* Do nothing. */
+        if ((depth) && ((next ^ 1u) == ((path[(depth-1u)/32u] >> (((depth-1u)%32u)*2u)) & 3u)))
+        {
+          *cell = hole;
+          depth--;
+        }
+        else
+        {
+          if ((depth/32u) == path.size())
+          {
+            path.push_back(0u);
+          }
+          path[depth/32u] &= ~(static_cast<uint64_t>(3u) << ((depth%32u)*2u));
+          path[depth/32u] |= static_cast<uint64_t>(next) << ((depth%32u)*2u);
+          depth++;
+          cell[offsets[next]] = solution;
+        }
+        cell += offsets[next];
+        y = next_y;
+        x = next_x;
+        direction = next;
+        break;
       }
     }
-    /* Right-hand rule and its priorities. */
-    else if (right == rule)
+  }
+}
+
+/**
+ * @brief   Solves a bit-packed maze with Dijstra's algorithm. It walks from cell to cell, using the passage bits.
+ *          The maze can't store the solution, so it is returned as a route instead.
+ * @param   &vect       - The bit-packed maze we want to solve.
+ * @param   entrance_y  - Y coordinate of the entrance (a cell or an opening on the boundary).
+ * @param   entrance_x  - X coordinate of the entrance (a cell or an opening on the boundary).
+ * @param   exit_y      - Y coordinate of the exit (a cell or an opening on the boundary).
+ * @param   exit_x      - X coordinate of the exit (a cell or an opening on the boundary).
+ * @param   &route      - Every [y,x] of the solution from the entrance to the exit. Empty if there is no solution.
+ * @return  void
+ */
+void maze::solver::dijkstra(const packed_grid &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<coordinate> &route)
+{
+  uint64_t start = packed_cell(vect, entrance_y, entrance_x);
+  uint64_t end = packed_cell(vect, exit_y, exit_x);
+  uint64_t columns = vect.get_columns();
+  uint64_t cells = static_cast<uint64_t>(vect.get_rows())*columns;
+
+  /* Two bits per cell: the direction back to the previous cell. */
+  std::vector<uint8_t> back((cells+3u)/4u, 0u);
+  std::vector<bool> visited(cells, false);
+  std::vector<uint64_t> current;
+  std::vector<uint64_t> next;
+  bool found = (start == end);
+
+  route.clear();
+  visited[start] = true;
+  current.push_back(start);
+
+  /* Walk away from the entrance, one distance at a time. */
+  while ((!found) && (!current.empty()))
+  {
+    next.clear();
+    for (uint64_t i = 0u; (i < current.size()) && (!found); i++)
     {
-      if (north == direction)
-      {
-        directions = {east, north, west, south};
-      }
-      else if (south == direction)
+      uint64_t cell = current[i];
+      uint64_t row = cell/columns;
+      uint64_t column = cell%columns;
+      uint64_t neighbours[4u];
+      uint32_t count = 0u;
+      uint8_t directions[4u];
+
+      /* The passages, that are open. Save the direction back to this cell too. */
+      if ((row > 0u) && vect.is_open_south(cell-columns))
       {
-        directions = {west, south, east, north};
+        neighbours[count] = cell-columns;
+        directions[count++] = south;
       }
-      else if (west == direction)
+      if (((row+1u) < vect.get_rows()) && vect.is_open_south(cell))
       {
-        directions = {north, west, south, east};
+        neighbours[count] = cell+columns;
+        directions[count++] = north;
       }
-      else if (east == direction)
+      if ((column > 0u) && vect.is_open_east(cell-1u))
       {
-        directions = {south, east, north, west};
+        neighbours[count] = cell-1u;
+        directions[count++] = east;
       }
-      else
+      if (((column+1u) < columns) && vect.is_open_east(cell))
       {
-        /* Do nothing. */
+        neighbours[count] = cell+1u;
+        directions[count++] = west;
       }
-    }
-    else
-    {
-      /* Do nothing. */
-    }
 
-    
-    /* Try to move in every direction. */
-    /* If it is possible to go there, then go (the directions are in priority order). */
-    /* If we haven't been there, then push it to the visited stack and mark as a solution. */
-    /* If we have been there, then pop it from the visited stack and remove the soliton mark. */
-    for (uint32_t i = 0u; i < directions.size(); i++)
-    {
-      if (north == directions[i])
-      {
-        if ((y > 0u) && (wall != vect[y-1u][x]))
-        {
-          uint32_t last = visited.size()-1u;
-          y--;
-          direction = north;
-          if (south == visited[last].direction)
-          {
-            vect[visited[last].y][visited[last].x] = hole;
-            visited.pop_back();
-          }
-          else
-          {
-            visited.push_back({y, x, direction});
-            vect[y][x] = solution;
-          }
-          break;
-        }
-      }
-      else if (south == directions[i])
-      {
-        if (((y+1u) < vect.size()) && (wall != vect[y+1u][x]))
-        {
-          uint32_t last = visited.size()-1u;
-          y++;
-          direction = south;
-          if (north == visited[last].direction)
-          {
-            vect[visited[last].y][visited[last].x] = hole;
-            visited.pop_back();
-          }
-          else
-          {
-            visited.push_back({y, x, direction});
-            vect[y][x] = solution;
-          }
-          break;
-        }
-      }
-      else if (west == directions[i])
-      {
-        if ((x > 0u) && (wall != vect[y][x-1u]))
-        {
-          uint32_t last = visited.size()-1u;
-          x--;
-          direction = west;
-          if (east == visited[last].direction)
-          {
-            vect[visited[last].y][visited[last].x] = hole;
-            visited.pop_back();
-          }
-          else
-          {
-            visited.push_back({y, x, direction});
-            vect[y][x] = solution;
-          }
-          break;
-        }
-      }
-      else if (east == directions[i])
+      for (uint32_t j = 0u; j < count; j++)
       {
-        if (((x+1u) < vect[0u].size()) && (wall != vect[y][x+1u]))
+        if (!visited[neighbours[j]])
         {
-          uint32_t last = visited.size()-1u;
-          x++;
-          direction = east;
-          if (west == visited[last].direction)
+          visited[neighbours[j]] = true;
+          back[neighbours[j]/4u] |= static_cast<uint8_t>(directions[j] << ((neighbours[j]%4u)*2u));
+          next.push_back(neighbours[j]);
+          if (end == neighbours[j])
           {
-            vect[visited[last].y][visited[last].x] = hole;
-            visited.pop_back();
+            found = true;
           }
-          else
-          {
-            visited.push_back({y, x, direction});
-            vect[y][x] = solution;
-          }
-          break;
         }
       }
-      else
-      {
-        /* Do nothing. */
-      }
     }
+    current.swap(next);
+  }
+
+  if (!found)
+  {
+    return;
+  }
+
+  /* Walk back from the exit to the entrance, then turn the cells into [y,x] coordinates. */
+  std::vector<uint64_t> cells_on_route;
+  for (uint64_t cell = end; cell != start; )
+  {
+    cells_on_route.push_back(cell);
+    uint8_t direction = (back[cell/4u] >> ((cell%4u)*2u)) & 3u;
+    if (north == direction)
+    {
+      cell -= columns;
+    }
+    else if (south == direction)
+    {
+      cell += columns;
+    }
+    else if (west == direction)
+    {
+      cell--;
+    }
+    else
+    {
+      cell++;
+    }
+  }
+  cells_on_route.push_back(start);
+  std::reverse(cells_on_route.begin(), cells_on_route.end());
+
+  /* The entrance and exit can be on the boundary, next to the first and last cell. */
+  uint32_t y = static_cast<uint32_t>(start/columns)*2u+1u;
+  uint32_t x = static_cast<uint32_t>(start%columns)*2u+1u;
+  if ((entrance_y != y) || (entrance_x != x))
+  {
+    route.push_back({entrance_y, entrance_x});
+  }
+  route.push_back({y, x});
+  for (uint64_t i = 1u; i < cells_on_route.size(); i++)
+  {
+    uint32_t next_y = static_cast<uint32_t>(cells_on_route[i]/columns)*2u+1u;
+    uint32_t next_x = static_cast<uint32_t>(cells_on_route[i]%columns)*2u+1u;
+    /* The passage between the two cells. */
+    route.push_back({(y+next_y)/2u, (x+next_x)/2u});
+    route.push_back({next_y, next_x});
+    y = next_y;
+    x = next_x;
+  }
+  if ((exit_y != y) || (exit_x != x))
+  {
+    route.push_back({exit_y, exit_x});
   }
 }
 
 /**
- * @brief   Error handler for the solver algorithms. It shall be insterted into every member function.
- * @param   &vect       - The vector-vector of the maze we want to solve. It overwrites the input one.
+ * @brief   Solves a maze with Dijkstra's algorithm on its junction graph. Only the junctions and dead ends are reached,
+ *          the corridors are skipped in one step. The cells of the solution can be listed with junction_graph::expand().
+ * @param   &graph      - The junction graph of the maze. It can be reused for any number of solutions.
  * @param   entrance_y  - Y coordinate of the entrance.
  * @param   entrance_x  - X coordinate of the entrance.
  * @param   exit_y      - Y coordinate of the exit.
  * @param   exit_x      - X coordinate of the exit.
+ * @param   &path       - The edges of the solution.
  * @return  void
  */
-void maze::solver::error_check(std::vector<std::vector<uint32_t>> vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+void maze::solver::dijkstra(const junction_graph &graph, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, junction_path &path)
 {
-  if ((vect.size() <= entrance_y) || (vect[0u].size() <= entrance_x) || (vect.size() <= exit_y) || (vect[0u].size() <= exit_x))
-  {
-    throw std::invalid_argument("Out of boundary!");
-  }
+  graph_search(graph, entrance_y, entrance_x, exit_y, exit_x, false, path);
+}
+
+/**
+ * @brief   Solves a maze with A* algorithm on its junction graph. The nodes closer to the exit (Manhattan distance) are preferred.
+ *          The cells of the solution can be listed with junction_graph::expand().
+ * @param   &graph      - The junction graph of the maze. It can be reused for any number of solutions.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   &path       - The edges of the solution.
+ * @return  void
+ */
+void maze::solver::astar(const junction_graph &graph, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, junction_path &path)
+{
+  graph_search(graph, entrance_y, entrance_x, exit_y, exit_x, true, path);
+}
+
+/**
+ * @brief   Solves the maze with hierarchical path finding. The path is searched on the transitions between the clusters first,
+ *          then only the clusters along it are searched cell by cell. It is for huge mazes, where even a single
+ *          breadth-first search takes too long. In mazes with loops the solution might be a few steps longer, than the shortest one.
+ * @param   &graph      - The cluster graph of the maze. It can be reused for any number of solutions.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::hierarchical(const cluster_graph &graph, grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  direction_path path;
+  hierarchical(graph, vect, entrance_y, entrance_x, exit_y, exit_x, path);
+  path.stamp(vect, solution);
+}
+
+/**
+ * @brief   Solves the maze like hierarchical() above, but the maze isn't changed: the solution is returned as a list of directions.
+ * @param   &graph      - The cluster graph of the maze. It can be reused for any number of solutions.
+ * @param   vect        - View of the maze we want to solve.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
+ * @return  void
+ */
+void maze::solver::hierarchical(const cluster_graph &graph, grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+  if ((graph.get_height() != vect.get_height()) || (graph.get_width() != vect.get_width()))
+  {
+    throw std::invalid_argument("The graph belongs to another maze.");
+  }
+  path.clear();
+
+  /* The entrance and the exit are connected to the nodes of their own cluster. */
+  std::vector<uint32_t> from_entrance;
+  std::vector<uint8_t> to_entrance;
+  std::vector<uint32_t> from_exit;
+  std::vector<uint8_t> to_exit;
+  graph.flood(vect, entrance_y, entrance_x, from_entrance, to_entrance);
+  graph.flood(vect, exit_y, exit_x, from_exit, to_exit);
+  uint32_t entrance_cluster = graph.cluster(entrance_y, entrance_x);
+  uint32_t exit_cluster = graph.cluster(exit_y, exit_x);
+
+  /* The best solution so far, and the node it leaves for the exit. */
+  uint64_t best = UINT64_MAX;
+  uint32_t best_node = cluster_graph::none;
+  if ((entrance_cluster == exit_cluster) && (cluster_graph::none != from_entrance[graph.local(exit_y, exit_x)]))
+  {
+    best = from_entrance[graph.local(exit_y, exit_x)];
+  }
+
+  uint32_t nodes = graph.get_nodes();
+  /* The entrance is an extra node after the real ones. */
+  uint32_t entrance = nodes;
+  std::vector<uint64_t> cost(nodes, UINT64_MAX);
+  std::vector<uint32_t> previous(nodes, entrance);
+  /* A step costs at most as many, as the cells of a cluster, and the estimate changes by as many. */
+  bucket_queue<uint32_t> open(2u*static_cast<uint64_t>(graph.get_size())*graph.get_size()+1u);
+
+  auto remaining = [&](uint32_t node) -> uint64_t
+  {
+    uint32_t y = graph.get_y(node);
+    uint32_t x = graph.get_x(node);
+    return static_cast<uint64_t>((y < exit_y) ? (exit_y-y) : (y-exit_y)) + ((x < exit_x) ? (exit_x-x) : (x-exit_x));
+  };
+
+  for (uint32_t node = graph.nodes_begin(entrance_cluster); node < graph.nodes_end(entrance_cluster); node++)
+  {
+    uint32_t steps = from_entrance[graph.local(graph.get_y(node), graph.get_x(node))];
+    if (cluster_graph::none != steps)
+    {
+      cost[node] = steps;
+      open.push(steps+remaining(node), node);
+    }
+  }
+
+  while (!open.empty())
+  {
+    uint64_t priority = open.top();
+    /* Nothing left in the queue can be shorter. */
+    if (priority >= best)
+    {
+      break;
+    }
+    uint32_t node = open.pop();
+    /* Lazy deletion: the node has been put into the queue again, with a smaller cost. */
+    if (priority != (cost[node]+remaining(node)))
+    {
+      continue;
+    }
+
+    uint32_t y = graph.get_y(node);
+    uint32_t x = graph.get_x(node);
+    if ((graph.cluster(y, x) == exit_cluster) && (cluster_graph::none != from_exit[graph.local(y, x)]) && ((cost[node]+from_exit[graph.local(y, x)]) < best))
+    {
+      best = cost[node]+from_exit[graph.local(y, x)];
+      best_node = node;
+    }
+
+    for (const cluster_graph::link *next = graph.links_begin(node); next != graph.links_end(node); next++)
+    {
+      uint64_t next_cost = cost[node]+next->weight;
+      if (next_cost < cost[next->node])
+      {
+        cost[next->node] = next_cost;
+        previous[next->node] = node;
+        open.push(next_cost+remaining(next->node), next->node);
+      }
+    }
+  }
+
+  if (UINT64_MAX == best)
+  {
+    return;
+  }
+
+  /* The solution is exactly best steps long. Most of it is walked back, towards the entrance, */
+  /* so the steps are filled from the end, and every step is the opposite of the move. */
+  path.reset(entrance_y, entrance_x, best);
+  uint64_t step = best;
+  std::vector<uint8_t> moves;
+  auto walked_back = [&]()
+  {
+    for (size_t i = 0u; i < moves.size(); i++)
+    {
+      step--;
+      path.set_step(step, static_cast<uint8_t>(moves[i] ^ 1u));
+    }
+  };
+
+  if (cluster_graph::none == best_node)
+  {
+    graph.trace(exit_y, exit_x, to_entrance, moves);
+    walked_back();
+    return;
+  }
+
+  /* Only the clusters along the path are searched again, cell by cell, from the exit back to the entrance. */
+  /* The first piece leads from the last node to the exit, so its moves are already forward. */
+  std::vector<uint32_t> steps;
+  std::vector<uint8_t> back;
+  uint32_t node = best_node;
+  graph.trace(graph.get_y(node), graph.get_x(node), to_exit, moves);
+  step -= moves.size();
+  for (size_t i = 0u; i < moves.size(); i++)
+  {
+    path.set_step(step+i, moves[i]);
+  }
+  while (entrance != previous[node])
+  {
+    uint32_t before = previous[node];
+    if (graph.cluster(graph.get_y(before), graph.get_x(before)) == graph.cluster(graph.get_y(node), graph.get_x(node)))
+    {
+      graph.flood(vect, graph.get_y(before), graph.get_x(before), steps, back, graph.local(graph.get_y(node), graph.get_x(node)));
+      graph.trace(graph.get_y(node), graph.get_x(node), back, moves);
+      walked_back();
+    }
+    else
+    {
+      /* The two sides of a transition are next to each other. */
+      step--;
+      path.set_step(step, towards(graph.get_y(before), graph.get_x(before), graph.get_y(node), graph.get_x(node)));
+    }
+    node = before;
+  }
+  graph.trace(graph.get_y(node), graph.get_x(node), to_entrance, moves);
+  walked_back();
+}
+
+/**
+ * @brief   Solves the maze with a breadth-first search on every thread. The threads expand the front together, one distance at a time,
+ *          and the cells are claimed with compare-and-swap, so every cell is reached by exactly one thread.
+ *          It pays off in big mazes with loops or rooms, where the front is wide. A narrow front is expanded by a single thread.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::parallel_bfs(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  direction_path path;
+  parallel_bfs(vect, entrance_y, entrance_x, exit_y, exit_x, path);
+  path.stamp(vect, solution);
+}
+
+/**
+ * @brief   Solves the maze like parallel_bfs() above, but the maze isn't changed: the solution is returned as a list of directions.
+ * @param   vect        - View of the maze we want to solve.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
+ * @return  void
+ */
+void maze::solver::parallel_bfs(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  std::vector<uint32_t> field;
+  level_search(vect, entrance_y, entrance_x, exit_y, exit_x, true, field);
+
+  size_t width = vect.get_width();
+  path.clear();
+  if (unreached == field[exit_y*width+exit_x])
+  {
+    return;
+  }
+
+  /* Walk back from the exit: there is always a neighbour one step closer to the entrance. */
+  /* The step forward is the opposite of the move, and the distance of the closer cell is its index. */
+  path.reset(entrance_y, entrance_x, field[exit_y*width+exit_x]);
+  uint32_t y = exit_y;
+  uint32_t x = exit_x;
+  while (0u != field[y*width+x])
+  {
+    uint32_t closer = field[y*width+x]-1u;
+    if ((y > 0u) && (closer == field[(y-1u)*width+x]))
+    {
+      y--;
+      path.set_step(closer, south);
+    }
+    else if (((y+1u) < vect.get_height()) && (closer == field[(y+1u)*width+x]))
+    {
+      y++;
+      path.set_step(closer, north);
+    }
+    else if ((x > 0u) && (closer == field[y*width+x-1u]))
+    {
+      x--;
+      path.set_step(closer, east);
+    }
+    else
+    {
+      x++;
+      path.set_step(closer, west);
+    }
+  }
+}
+
+/**
+ * @brief   Solves the maze with a breadth-first search on bit planes (see bitplane_wave), 64 or 256 cells in one instruction.
+ *          Only the distance modulo 3 is saved, the solution is found by walking back from the exit to a neighbour one step closer.
+ * @param   vect        - View of the maze we want to solve. It overwrites the maze behind it.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::wavefront(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  direction_path path;
+  wavefront(vect, entrance_y, entrance_x, exit_y, exit_x, path);
+  path.stamp(vect, solution);
+}
+
+/**
+ * @brief   Solves the maze like wavefront() above, but the maze isn't changed: the solution is returned as a list of directions.
+ * @param   vect        - View of the maze we want to solve.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance, not found if there is none.
+ * @return  void
+ */
+void maze::solver::wavefront(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  error_check(vect, entrance_y, entrance_x, exit_y, exit_x);
+
+  bitplane_wave wave(vect);
+  uint32_t steps = wave.run(entrance_y, entrance_x, exit_y, exit_x);
+  path.clear();
+  if (bitplane_wave::unreached == steps)
+  {
+    return;
+  }
+
+  /* The neighbours of a cell are at most one step closer or further, so modulo 3 tells which one is closer. */
+  /* The step forward is the opposite of the move, and it is filled from the end. */
+  path.reset(entrance_y, entrance_x, steps);
+  uint32_t y = exit_y;
+  uint32_t x = exit_x;
+  for (; 0u != steps; steps--)
+  {
+    uint32_t closer = (steps-1u) % 3u;
+    if ((y > 0u) && wave.reached(y-1u, x) && (closer == wave.level(y-1u, x)))
+    {
+      y--;
+      path.set_step(steps-1u, south);
+    }
+    else if (((y+1u) < vect.get_height()) && wave.reached(y+1u, x) && (closer == wave.level(y+1u, x)))
+    {
+      y++;
+      path.set_step(steps-1u, north);
+    }
+    else if ((x > 0u) && wave.reached(y, x-1u) && (closer == wave.level(y, x-1u)))
+    {
+      x--;
+      path.set_step(steps-1u, east);
+    }
+    else
+    {
+      x++;
+      path.set_step(steps-1u, west);
+    }
+  }
+}
+
+/**
+ * @brief   Finds the distance of every cell from a cell, with the same parallel breadth-first search as parallel_bfs().
+ * @param   vect    - View of the maze. It isn't changed.
+ * @param   y       - Y coordinate of the cell.
+ * @param   x       - X coordinate of the cell.
+ * @param   &field  - Distance of every cell (y*width+x), unreached for walls and cells, that can't be reached.
+ * @return  void
+ */
+void maze::solver::distance_field(grid_view vect, uint32_t y, uint32_t x, std::vector<uint32_t> &field)
+{
+  error_check(vect, y, x, y, x);
+  level_search(vect, y, x, y, x, false, field);
+}
+
+/**
+ * @brief   Sets how many threads parallel_bfs() and distance_field() can use.
+ * @param   new_threads - Number of threads, 0 means every hardware thread. This is the default.
+ * @return  void
+ */
+void maze::solver::set_threads(uint32_t new_threads)
+{
+  threads = new_threads;
+}
+
+/**
+ * @brief   Error handler for the solver algorithms. It shall be insterted into every member function.
+ * @param   vect        - View of the maze we want to check.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::error_check(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  if ((vect.get_height() <= entrance_y) || (vect.get_width() <= entrance_x) || (vect.get_height() <= exit_y) || (vect.get_width() <= exit_x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+
+  if ((hole != vect(entrance_y, entrance_x)) || (hole != vect(exit_y, exit_x)))
+  {
+    throw std::invalid_argument("The entrance and exit must be holes (1).");
+  }
+}
+
+
+/**
+ * @brief   Finds the cell of a bit-packed maze, that belongs to an entrance or exit.
+ * @param   &vect - The bit-packed maze.
+ * @param   y     - Y coordinate of the entrance or exit (a cell or an opening on the boundary).
+ * @param   x     - X coordinate of the entrance or exit (a cell or an opening on the boundary).
+ * @return  The index of the cell.
+ */
+uint64_t maze::solver::packed_cell(const packed_grid &vect, uint32_t y, uint32_t x)
+{
+  if ((vect.get_height() <= y) || (vect.get_width() <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+
+  if (hole != vect.get(y, x))
+  {
+    throw std::invalid_argument("The entrance and exit must be holes (1).");
+  }
+
+  uint32_t row = y/2u;
+  uint32_t column = x/2u;
+
+  /* An opening on the boundary belongs to the cell next to it. */
+  if ((y & 1u) && (x & 1u))
+  {
+    /* Do nothing. */
+  }
+  else if ((x & 1u) && ((0u == y) || ((vect.get_height()-1u) == y)))
+  {
+    row = (0u == y) ? 0u : (vect.get_rows()-1u);
+  }
+  else if ((y & 1u) && ((0u == x) || ((vect.get_width()-1u) == x)))
+  {
+    column = (0u == x) ? 0u : (vect.get_columns()-1u);
+  }
+  else
+  {
+    throw std::invalid_argument("The entrance and exit must be cells or openings on the boundary.");
+  }
+
+  return static_cast<uint64_t>(row)*vect.get_columns() + column;
+}
+
+/**
+ * @brief   Shortest path search on a junction graph. The edges have different weights, but a priority can only grow
+ *          by two times the longest edge in a step, so the bucket queue still works, it just needs more buckets.
+ *          The entrance and the exit can be inside corridors, then they are connected to the two ends of their corridor.
+ * @param   &graph      - The junction graph of the maze.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   estimate    - Add the Manhattan distance to the exit to the priorities (A*) or not (Dijkstra's).
+ * @param   &path       - The edges of the solution.
+ * @return  void
+ */
+void maze::solver::graph_search(const junction_graph &graph, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, bool estimate, junction_path &path)
+{
+  junction_graph::anchor sources[2u];
+  junction_graph::anchor targets[2u];
+  uint32_t source_count = graph.anchors(entrance_y, entrance_x, sources);
+  uint32_t target_count = graph.anchors(exit_y, exit_x, targets);
+
+  path.entrance_y = entrance_y;
+  path.entrance_x = entrance_x;
+  path.exit_y = exit_y;
+  path.exit_x = exit_x;
+  path.found = (entrance_y == exit_y) && (entrance_x == exit_x);
+  path.length = 0u;
+  path.hops.clear();
+  if (path.found)
+  {
+    return;
+  }
+
+  /* The best solution so far: the node it leaves for the exit and its last edge. */
+  uint64_t best = UINT64_MAX;
+  uint32_t best_node = junction_graph::none;
+  uint32_t best_hop = junction_graph::none;
+
+  /* Both are inside the same corridor, maybe it is the shortest to walk along it. */
+  if ((2u == source_count) && (2u == target_count) && ((sources[0u].hop >> 1u) == (targets[0u].hop >> 1u)))
+  {
+    uint32_t from = sources[0u].length;
+    uint32_t to = targets[0u].length;
+    best = (from < to) ? (to-from) : (from-to);
+    best_hop = (sources[0u].hop & ~1u) | ((to < from) ? 1u : 0u);
+  }
+
+  uint32_t nodes = graph.get_nodes();
+  /* The entrance is an extra node after the real ones. */
+  uint32_t entrance = nodes;
+  std::vector<uint64_t> cost(nodes, UINT64_MAX);
+  std::vector<uint32_t> previous(nodes, entrance);
+  std::vector<uint32_t> via(nodes, static_cast<uint32_t>(junction_graph::none));
+  bucket_queue<uint32_t> open(2u*static_cast<uint64_t>(graph.get_longest())+1u);
+
+  auto remaining = [&](uint32_t node) -> uint64_t
+  {
+    if (!estimate)
+    {
+      return 0u;
+    }
+    uint32_t y = graph.get_y(node);
+    uint32_t x = graph.get_x(node);
+    return static_cast<uint64_t>((y < exit_y) ? (exit_y-y) : (y-exit_y)) + ((x < exit_x) ? (exit_x-x) : (x-exit_x));
+  };
+
+  for (uint32_t i = 0u; i < source_count; i++)
+  {
+    if (sources[i].length < cost[sources[i].node])
+    {
+      cost[sources[i].node] = sources[i].length;
+      via[sources[i].node] = sources[i].hop;
+      open.push(sources[i].length+remaining(sources[i].node), sources[i].node);
+    }
+  }
+
+  while (!open.empty())
+  {
+    uint64_t priority = open.top();
+    /* Nothing left in the queue can be shorter. */
+    if (priority >= best)
+    {
+      break;
+    }
+    uint32_t node = open.pop();
+    /* Lazy deletion: the node has been put into the queue again, with a smaller cost. */
+    if (priority != (cost[node]+remaining(node)))
+    {
+      continue;
+    }
+
+    for (uint32_t i = 0u; i < target_count; i++)
+    {
+      if ((targets[i].node == node) && ((cost[node]+targets[i].length) < best))
+      {
+        best = cost[node]+targets[i].length;
+        best_node = node;
+        best_hop = (junction_graph::none == targets[i].hop) ? junction_graph::none : (targets[i].hop ^ 1u);
+      }
+    }
+
+    for (const junction_graph::link *next = graph.links_begin(node); next != graph.links_end(node); next++)
+    {
+      uint64_t next_cost = cost[node]+next->weight;
+      if (next_cost < cost[next->node])
+      {
+        cost[next->node] = next_cost;
+        previous[next->node] = node;
+        via[next->node] = next->hop;
+        open.push(next_cost+remaining(next->node), next->node);
+      }
+    }
+  }
+
+  if (UINT64_MAX == best)
+  {
+    return;
+  }
+
+  /* Walk back from the exit to the entrance, then turn the edges around. */
+  if (junction_graph::none != best_hop)
+  {
+    path.hops.push_back(best_hop);
+  }
+  for (uint32_t node = best_node; (junction_graph::none != node) && (node != entrance); node = previous[node])
+  {
+    if (junction_graph::none != via[node])
+    {
+      path.hops.push_back(via[node]);
+    }
+  }
+  std::reverse(path.hops.begin(), path.hops.end());
+  path.found = true;
+  path.length = best;
+}
+
+/**
+ * @brief   Level-synchronous breadth-first search on many threads. Every level has two ways to go:
+ *          - Top-down: the threads take chunks of the front, and claim the unvisited neighbours of its cells.
+ *          - Bottom-up: every thread checks its own rows, whether an unvisited cell has a neighbour in the front.
+ *          Bottom-up is chosen, when the front is so big, that checking the unvisited cells is cheaper.
+ *          Between the levels the last thread to arrive swaps the fronts and decides alone. It also expands the narrow fronts alone.
+ * @param   vect    - View of the maze.
+ * @param   y       - Y coordinate of the start.
+ * @param   x       - X coordinate of the start.
+ * @param   stop_y  - Y coordinate of the cell, where the search can stop.
+ * @param   stop_x  - X coordinate of the cell, where the search can stop.
+ * @param   stop    - Stop at stop_y, stop_x or search every cell.
+ * @param   &field  - Distance of every cell (y*width+x) from the start, unreached if it hasn't been reached.
+ * @return  void
+ */
+void maze::solver::level_search(grid_view vect, uint32_t y, uint32_t x, uint32_t stop_y, uint32_t stop_x, bool stop, std::vector<uint32_t> &field)
+{
+  uint32_t height = vect.get_height();
+  uint32_t width = vect.get_width();
+  size_t cells = static_cast<size_t>(height)*width;
+  uint32_t thread_count = (0u == threads) ? std::thread::hardware_concurrency() : threads;
+  thread_count = (0u == thread_count) ? 1u : thread_count;
+
+  field.assign(cells, static_cast<uint32_t>(unreached));
+  /* One bit per cell: reached already. Another one: part of the current front, only for the bottom-up levels. */
+  std::vector<std::atomic<uint64_t>> visited((cells+63u)/64u);
+  std::vector<std::atomic<uint64_t>> in_front((cells+63u)/64u);
+  /* Every thread has its own fronts, so it doesn't need to lock anything to save a cell. */
+  std::vector<std::vector<distance>> current(thread_count);
+  std::vector<std::vector<distance>> next(thread_count);
+  std::vector<size_t> offsets(thread_count+1u, 0u);
+  std::atomic<size_t> taken(0u);
+  thread_barrier barrier(thread_count);
+
+  uint32_t level = 0u;
+  size_t front = 1u;
+  size_t explored = 1u;
+  bool started = false;
+  bool finished = false;
+  bool bottom_up = false;
+
+  /* Test and test-and-set: the bit is only written, if it was clear when it was read. */
+  auto claim = [&](size_t cell) -> bool
+  {
+    std::atomic<uint64_t> &word = visited[cell/64u];
+    uint64_t bit = static_cast<uint64_t>(1u) << (cell%64u);
+    uint64_t old = word.load(std::memory_order_relaxed);
+    while (!(old & bit))
+    {
+      if (word.compare_exchange_weak(old, old | bit, std::memory_order_relaxed))
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto reach = [&](uint32_t next_y, uint32_t next_x, std::vector<distance> &target)
+  {
+    size_t cell = static_cast<size_t>(next_y)*width+next_x;
+    if ((hole == vect(next_y, next_x)) && claim(cell))
+    {
+      field[cell] = level+1u;
+      target.push_back({next_y, next_x});
+    }
+  };
+
+  auto expand = [&](const distance &cell, std::vector<distance> &target)
+  {
+    if (cell.y > 0u)
+    {
+      reach(cell.y-1u, cell.x, target);
+    }
+    if ((cell.y+1u) < height)
+    {
+      reach(cell.y+1u, cell.x, target);
+    }
+    if (cell.x > 0u)
+    {
+      reach(cell.y, cell.x-1u, target);
+    }
+    if ((cell.x+1u) < width)
+    {
+      reach(cell.y, cell.x+1u, target);
+    }
+  };
+
+  /* The next front becomes the current one. */
+  auto advance = [&]()
+  {
+    front = 0u;
+    for (uint32_t i = 0u; i < thread_count; i++)
+    {
+      std::swap(current[i], next[i]);
+      next[i].clear();
+      front += current[i].size();
+    }
+    explored += front;
+    level++;
+    finished = (0u == front) || (stop && (unreached != field[static_cast<size_t>(stop_y)*width+stop_x]));
+  };
+
+  /* Runs alone, between two levels. */
+  auto plan = [&]()
+  {
+    while ((!finished) && (front < serial_front))
+    {
+      for (uint32_t i = 0u; i < thread_count; i++)
+      {
+        for (const distance &cell : current[i])
+        {
+          expand(cell, next[0u]);
+        }
+      }
+      advance();
+    }
+    if (finished)
+    {
+      return;
+    }
+
+    bottom_up = bottom_up ? (front >= (cells/to_top_down)) : (front > ((cells-std::min(cells, explored))/to_bottom_up));
+    for (uint32_t i = 0u; i < thread_count; i++)
+    {
+      offsets[i+1u] = offsets[i]+current[i].size();
+    }
+    taken = 0u;
+  };
+
+  auto work = [&](uint32_t self)
+  {
+    while (true)
+    {
+      barrier.wait([&]()
+      {
+        /* The very first front is only the start, there is nothing to swap. */
+        if (started)
+        {
+          advance();
+        }
+        started = true;
+        plan();
+      });
+      if (finished)
+      {
+        break;
+      }
+
+      if (bottom_up)
+      {
+        for (const distance &cell : current[self])
+        {
+          size_t index = static_cast<size_t>(cell.y)*width+cell.x;
+          in_front[index/64u].fetch_or(static_cast<uint64_t>(1u) << (index%64u), std::memory_order_relaxed);
+        }
+        barrier.wait([]() {});
+
+        /* Every thread checks its own rows. */
+        auto front_bit = [&](size_t cell) -> bool
+        {
+          return (in_front[cell/64u].load(std::memory_order_relaxed) >> (cell%64u)) & 1u;
+        };
+        uint32_t first_row = static_cast<uint32_t>((static_cast<uint64_t>(height)*self)/thread_count);
+        uint32_t last_row = static_cast<uint32_t>((static_cast<uint64_t>(height)*(self+1u))/thread_count);
+        for (uint32_t row = first_row; row < last_row; row++)
+        {
+          for (uint32_t column = 0u; column < width; column++)
+          {
+            size_t cell = static_cast<size_t>(row)*width+column;
+            if (((visited[cell/64u].load(std::memory_order_relaxed) >> (cell%64u)) & 1u) || (hole != vect(row, column)))
+            {
+              continue;
+            }
+            if (((row > 0u) && front_bit(cell-width)) || (((row+1u) < height) && front_bit(cell+width)) ||
+                ((column > 0u) && front_bit(cell-1u)) || (((column+1u) < width) && front_bit(cell+1u)))
+            {
+              /* Only this thread checks this cell, but the bits of the word can belong to the rows of the neighbour thread. */
+              claim(cell);
+              field[cell] = level+1u;
+              next[self].push_back({row, column});
+            }
+          }
+        }
+        barrier.wait([]() {});
+
+        for (const distance &cell : current[self])
+        {
+          size_t index = static_cast<size_t>(cell.y)*width+cell.x;
+          in_front[index/64u].fetch_and(~(static_cast<uint64_t>(1u) << (index%64u)), std::memory_order_relaxed);
+        }
+      }
+      else
+      {
+        /* The fronts of the threads are taken as one list, in chunks, so a thread with a long front doesn't slow down the others. */
+        size_t owner = 0u;
+        for (size_t begin = taken.fetch_add(chunk); begin < offsets[thread_count]; begin = taken.fetch_add(chunk))
+        {
+          size_t end = std::min(begin+chunk, offsets[thread_count]);
+          for (size_t i = begin; i < end; i++)
+          {
+            while (i >= offsets[owner+1u])
+            {
+              owner++;
+            }
+            while (i < offsets[owner])
+            {
+              owner--;
+            }
+            expand(current[owner][i-offsets[owner]], next[self]);
+          }
+        }
+      }
+    }
+  };
+
+  size_t start = static_cast<size_t>(y)*width+x;
+  field[start] = 0u;
+  visited[start/64u] = static_cast<uint64_t>(1u) << (start%64u);
+  current[0u].push_back({y, x});
+  finished = stop && (y == stop_y) && (x == stop_x);
+
+  std::vector<std::thread> workers;
+  for (uint32_t i = 1u; i < thread_count; i++)
+  {
+    workers.emplace_back(work, i);
+  }
+  work(0u);
+  for (uint32_t i = 0u; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+}
+
+/**
+ * @brief   Returns the direction of a step between two neighbouring cells.
+ * @param   from_y  - Y coordinate of the first cell.
+ * @param   from_x  - X coordinate of the first cell.
+ * @param   to_y    - Y coordinate of the second cell.
+ * @param   to_x    - X coordinate of the second cell.
+ * @return  North, south, west or east.
+ */
+uint8_t maze::solver::towards(uint32_t from_y, uint32_t from_x, uint32_t to_y, uint32_t to_x)
+{
+  uint8_t direction = east;
+  if (to_y < from_y)
+  {
+    direction = north;
+  }
+  else if (to_y > from_y)
+  {
+    direction = south;
+  }
+  else if (to_x < from_x)
+  {
+    direction = west;
+  }
+  else
+  {
+    /* Do nothing. */
+  }
+  return direction;
+}
+
+/**
+ * @brief   Walks back from the exit to the entrance, following the saved directions, and marks the solution.
+ * @param   vect        - View of the maze.
+ * @param   &back       - Two bits per cell: the direction back to the previous cell.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @return  void
+ */
+void maze::solver::trace_back(grid_view vect, const std::vector<uint8_t> &back, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x)
+{
+  size_t width = vect.get_width();
+  uint32_t y = exit_y;
+  uint32_t x = exit_x;
+  while ((y != entrance_y) || (x != entrance_x))
+  {
+    vect(y, x) = solution;
+    size_t cell = y*width+x;
+    uint8_t direction = (back[cell/4u] >> ((cell%4u)*2u)) & 3u;
+    if (north == direction)
+    {
+      y--;
+    }
+    else if (south == direction)
+    {
+      y++;
+    }
+    else if (west == direction)
+    {
+      x--;
+    }
+    else
+    {
+      x++;
+    }
+  }
+  vect(y, x) = solution;
+}
+
+/**
+ * @brief   The breadth-first walk of dijkstra(), from the entrance until it reaches the exit.
+ * @param   vect        - View of the maze.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   &back       - Two bits per cell: the direction back to the cell, that it has been reached from.
+ * @return  True if the exit has been reached.
+ */
+bool maze::solver::breadth_first(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<uint8_t> &back)
+{
+  size_t width = vect.get_width();
+  size_t cells = static_cast<size_t>(vect.get_height())*width;
+  /* One bit per cell, set when the cell has been reached. */
+  std::vector<uint64_t> reached((cells+63u)/64u, 0u);
+  /* Two bits per cell: the direction back to the cell, that it has been reached from. */
+  back.assign((cells+3u)/4u, 0u);
+  /* The front is usually not longer than the perimeter. If it is, the queue grows. */
+  ring_queue<distance> front(2u*(vect.get_height()+width));
+  bool found = false;
+
+  /* Saves a neighbour into the front, if it is a hole and it hasn't been reached yet. */
+  auto reach = [&](uint32_t y, uint32_t x, uint8_t direction)
+  {
+    size_t cell = y*width+x;
+    if ((hole == vect(y, x)) && (!((reached[cell/64u] >> (cell%64u)) & 1u)))
+    {
+      reached[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
+      back[cell/4u] |= static_cast<uint8_t>(direction << ((cell%4u)*2u));
+      front.push({y, x});
+    }
+  };
+
+  size_t start = entrance_y*width+entrance_x;
+  reached[start/64u] |= static_cast<uint64_t>(1u) << (start%64u);
+  front.push({entrance_y, entrance_x});
+
+  /* Walk away from the entrance, the closest cells first. */
+  while (!front.empty())
+  {
+    distance current = front.pop();
+    uint32_t y = current.y;
+    uint32_t x = current.x;
+
+    /* Stop at the end. It could run and check every cell in the maze, but it would be waste of time. */
+    if ((y == exit_y) && (x == exit_x))
+    {
+      found = true;
+      break;
+    }
+
+    if (y > 0u)
+    {
+      reach(y-1u, x, south);
+    }
+    if ((y+1u) < vect.get_height())
+    {
+      reach(y+1u, x, north);
+    }
+    if (x > 0u)
+    {
+      reach(y, x-1u, east);
+    }
+    if ((x+1u) < vect.get_width())
+    {
+      reach(y, x+1u, west);
+    }
+  }
+
+  return found;
+}
+
+/**
+ * @brief   The search of astar(), from the entrance until it expands the exit.
+ * @param   vect        - View of the maze.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   &back       - Two bits per cell: the direction back to the cell, that it has been expanded from.
+ * @return  True if the exit has been reached.
+ */
+bool maze::solver::best_first(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<uint8_t> &back)
+{
+  size_t width = vect.get_width();
+  size_t cells = static_cast<size_t>(vect.get_height())*width;
+  /* One bit per cell, set when the cell has been expanded. Then its shortest distance is known. */
+  std::vector<uint64_t> closed((cells+63u)/64u, 0u);
+  /* Two bits per cell: the direction back to the cell, that it has been expanded from. */
+  back.assign((cells+3u)/4u, 0u);
+  /* The priority is the distance from the entrance plus the estimated distance to the exit. */
+  /* A step changes it by 0 or 2, so every priority in the queue is within a span of 3. */
+  bucket_queue<element> open(3u);
+  bool found = false;
+
+  /* Manhattan distance from the exit. It never overestimates, so the solution is the shortest one. */
+  auto estimate = [&](uint32_t y, uint32_t x) -> uint64_t
+  {
+    return ((y > exit_y) ? (y-exit_y) : (exit_y-y)) + ((x > exit_x) ? (x-exit_x) : (exit_x-x));
+  };
+
+  open.push(estimate(entrance_y, entrance_x), {entrance_y, entrance_x, north});
+
+  while (!open.empty())
+  {
+    uint64_t priority = open.top();
+    element current = open.pop();
+    uint32_t y = current.y;
+    uint32_t x = current.x;
+    size_t cell = y*width+x;
+
+    /* A cell can be in the queue more than once, only the first (shortest) one counts. */
+    if ((closed[cell/64u] >> (cell%64u)) & 1u)
+    {
+      continue;
+    }
+    closed[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
+    back[cell/4u] |= static_cast<uint8_t>(current.direction << ((cell%4u)*2u));
+
+    if ((y == exit_y) && (x == exit_x))
+    {
+      found = true;
+      break;
+    }
+
+    /* Saves a neighbour into the queue, if it is a hole and it hasn't been expanded yet. */
+    uint64_t steps = priority-estimate(y, x)+1u;
+    auto open_cell = [&](uint32_t next_y, uint32_t next_x, uint8_t direction)
+    {
+      size_t next_cell = next_y*width+next_x;
+      if ((hole == vect(next_y, next_x)) && (!((closed[next_cell/64u] >> (next_cell%64u)) & 1u)))
+      {
+        open.push(steps+estimate(next_y, next_x), {next_y, next_x, direction});
+      }
+    };
+
+    if (y > 0u)
+    {
+      open_cell(y-1u, x, south);
+    }
+    if ((y+1u) < vect.get_height())
+    {
+      open_cell(y+1u, x, north);
+    }
+    if (x > 0u)
+    {
+      open_cell(y, x-1u, east);
+    }
+    if ((x+1u) < vect.get_width())
+    {
+      open_cell(y, x+1u, west);
+    }
+  }
+
+  return found;
+}
+
+/**
+ * @brief   The search of weighted(), from the entrance until it expands the exit.
+ * @param   vect        - View of the maze.
+ * @param   costs       - View of the cost of stepping into every cell.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   &back       - Two bits per cell: the direction back to the cell, that it has been expanded from.
+ * @return  True if the exit has been reached.
+ */
+bool maze::solver::cheapest_first(grid_view vect, grid_view costs, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<uint8_t> &back)
+{
+  if ((vect.get_height() != costs.get_height()) || (vect.get_width() != costs.get_width()))
+  {
+    throw std::invalid_argument("The costs must have the same size as the maze.");
+  }
+
+  size_t width = vect.get_width();
+  size_t cells = static_cast<size_t>(vect.get_height())*width;
+  /* One bit per cell, set when the cell has been expanded. Then its cheapest cost is known. */
+  std::vector<uint64_t> closed((cells+63u)/64u, 0u);
+  back.assign((cells+3u)/4u, 0u);
+  /* A step costs at most 255, so every priority in the queue is within a span of 256 from the lowest one. */
+  bucket_queue<element> open(UINT8_MAX+1u);
+  bool found = false;
 
-  if ((hole != vect[entrance_y][entrance_x]) || (hole != vect[entrance_y][entrance_x]))
+  open.push(0u, {entrance_y, entrance_x, north});
+
+  while (!open.empty())
   {
-    throw std::invalid_argument("The entrance and exit must be holes (0).");
+    uint64_t priority = open.top();
+    element current = open.pop();
+    uint32_t y = current.y;
+    uint32_t x = current.x;
+    size_t cell = y*width+x;
+
+    /* A cell can be in the queue once from every neighbour, only the first (cheapest) one counts. */
+    if ((closed[cell/64u] >> (cell%64u)) & 1u)
+    {
+      continue;
+    }
+    closed[cell/64u] |= static_cast<uint64_t>(1u) << (cell%64u);
+    back[cell/4u] |= static_cast<uint8_t>(current.direction << ((cell%4u)*2u));
+
+    if ((y == exit_y) && (x == exit_x))
+    {
+      found = true;
+      break;
+    }
+
+    /* Saves a neighbour into the queue, if it can be entered and it hasn't been expanded yet. */
+    auto open_cell = [&](uint32_t next_y, uint32_t next_x, uint8_t direction)
+    {
+      size_t next_cell = next_y*width+next_x;
+      if ((hole == vect(next_y, next_x)) && (0u != costs(next_y, next_x)) && (!((closed[next_cell/64u] >> (next_cell%64u)) & 1u)))
+      {
+        open.push(priority+costs(next_y, next_x), {next_y, next_x, direction});
+      }
+    };
+
+    if (y > 0u)
+    {
+      open_cell(y-1u, x, south);
+    }
+    if ((y+1u) < vect.get_height())
+    {
+      open_cell(y+1u, x, north);
+    }
+    if (x > 0u)
+    {
+      open_cell(y, x-1u, east);
+    }
+    if ((x+1u) < vect.get_width())
+    {
+      open_cell(y, x+1u, west);
+    }
   }
+
+  return found;
 }
 
+/**
+ * @brief   Walks back from the exit to the entrance, following the saved directions, and saves the steps forward into a path.
+ * @param   width       - Width of the maze.
+ * @param   &back       - Two bits per cell: the direction back to the previous cell.
+ * @param   entrance_y  - Y coordinate of the entrance.
+ * @param   entrance_x  - X coordinate of the entrance.
+ * @param   exit_y      - Y coordinate of the exit.
+ * @param   exit_x      - X coordinate of the exit.
+ * @param   path        - The solution from the entrance.
+ * @return  void
+ */
+void maze::solver::trace_path(size_t width, const std::vector<uint8_t> &back, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path)
+{
+  /* The walk goes backwards, so it is done twice: first for the length, then the steps are filled from the end. */
+  uint64_t length = 0u;
+  for (uint32_t pass = 0u; pass < 2u; pass++)
+  {
+    uint32_t y = exit_y;
+    uint32_t x = exit_x;
+    uint64_t step = length;
+    while ((y != entrance_y) || (x != entrance_x))
+    {
+      size_t cell = y*width+x;
+      uint8_t direction = (back[cell/4u] >> ((cell%4u)*2u)) & 3u;
+      if (0u == pass)
+      {
+        length++;
+      }
+      else
+      {
+        /* The step forward is the opposite of the direction back: north and south, west and east only differ in the last bit. */
+        step--;
+        path.set_step(step, static_cast<uint8_t>(direction ^ 1u));
+      }
+
+      if (north == direction)
+      {
+        y--;
+      }
+      else if (south == direction)
+      {
+        y++;
+      }
+      else if (west == direction)
+      {
+        x--;
+      }
+      else
+      {
+        x++;
+      }
+    }
+    if (0u == pass)
+    {
+      path.reset(entrance_y, entrance_x, length);
+    }
+  }
+}
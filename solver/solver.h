@@ -14,45 +14,101 @@
 #include <random>
 #include <algorithm>
 #include "maze_generator.h"
+#include "ring_queue.h"
+#include "bucket_queue.h"
 
 namespace maze
 {
+  class junction_graph;
+  struct junction_path;
+  class cluster_graph;
+  class direction_path;
+
   class solver
   {
     public:
-      void dead_end(std::vector<std::vector<uint32_t>> &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
-      void dijkstra(std::vector<std::vector<uint32_t>> &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
-      void wall_follower(std::vector<std::vector<uint32_t>> &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, uint32_t rule = left);
+      /* A single [y,x] position of a route. */
+      struct coordinate {
+        uint32_t y;
+        uint32_t x;
+      };
+
+      void dead_end(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void dijkstra(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void wall_follower(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, uint32_t rule = left);
+      void astar(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void bidirectional(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+
+      void dijkstra(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+      void astar(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+      void bidirectional(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+
+      void weighted(grid_view vect, grid_view costs, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void weighted(grid_view vect, grid_view costs, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+
+      void dijkstra(const packed_grid &vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<coordinate> &route);
+
+      void dijkstra(const junction_graph &graph, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, junction_path &path);
+      void astar(const junction_graph &graph, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, junction_path &path);
+
+      void hierarchical(const cluster_graph &graph, grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void hierarchical(const cluster_graph &graph, grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+
+      void parallel_bfs(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void wavefront(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void parallel_bfs(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+      void wavefront(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+      void distance_field(grid_view vect, uint32_t y, uint32_t x, std::vector<uint32_t> &field);
+      void set_threads(uint32_t new_threads);
 
       static constexpr uint32_t left  = 0u;
       static constexpr uint32_t right = 1u;
 
+      static constexpr uint32_t unreached = UINT32_MAX; /**< Distance of the cells, that can't be reached. */
+
     private:
-      static constexpr uint32_t wall        = maze_generator::wall;
-      static constexpr uint32_t hole        = maze_generator::hole;
-      static constexpr uint32_t solution    = maze_generator::solution;
-      static constexpr uint32_t dead        = 3u;
-      static constexpr uint32_t never_dead  = 4u;
+      static constexpr uint8_t wall        = maze_generator::wall;
+      static constexpr uint8_t hole        = maze_generator::hole;
+      static constexpr uint8_t solution    = maze_generator::solution;
+      static constexpr uint8_t dead        = 3u;
+      static constexpr uint8_t never_dead  = 4u;
 
       static constexpr uint8_t north  = 0u;
       static constexpr uint8_t south  = 1u;
       static constexpr uint8_t west   = 2u;
       static constexpr uint8_t east   = 3u;
 
-      /* For wall follower algorithm. */
+      /* For the parallel breadth-first search. */
+      static constexpr size_t serial_front  = 1024u;  /**< A smaller front is expanded by a single thread, it isn't worth waking the others. */
+      static constexpr size_t chunk         = 256u;   /**< The threads take this many cells of the front at once. */
+      static constexpr size_t to_bottom_up  = 14u;    /**< Bottom-up, when the front is bigger, than the unexplored cells divided by this. */
+      static constexpr size_t to_top_down   = 24u;    /**< Top-down again, when the front is smaller, than every cell divided by this. */
+
+      uint32_t threads = 0u;
+
+      /* For A* algorithm. */
       struct element {
         uint32_t y;
         uint32_t x;
         uint32_t direction;
       };
 
-      /* For Dijkstra's algorithm. */
+      /* For Dijkstra's and dead-end filling algorithms. */
       struct distance {
         uint32_t y;
         uint32_t x;
       };
 
-      void error_check(std::vector<std::vector<uint32_t>> vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void error_check(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      uint64_t packed_cell(const packed_grid &vect, uint32_t y, uint32_t x);
+      static uint8_t towards(uint32_t from_y, uint32_t from_x, uint32_t to_y, uint32_t to_x);
+      void trace_back(grid_view vect, const std::vector<uint8_t> &back, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x);
+      void trace_path(size_t width, const std::vector<uint8_t> &back, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, direction_path &path);
+      bool breadth_first(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<uint8_t> &back);
+      bool best_first(grid_view vect, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<uint8_t> &back);
+      bool cheapest_first(grid_view vect, grid_view costs, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, std::vector<uint8_t> &back);
+      void graph_search(const junction_graph &graph, uint32_t entrance_y, uint32_t entrance_x, uint32_t exit_y, uint32_t exit_x, bool estimate, junction_path &path);
+      void level_search(grid_view vect, uint32_t y, uint32_t x, uint32_t stop_y, uint32_t stop_x, bool stop, std::vector<uint32_t> &field);
 
   };
 }
@@ -0,0 +1,320 @@
+/**
+ * @file    tree_index.cpp
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Index of a perfect maze for fast path queries between any two cells.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#include "tree_index.h"
+
+/**
+ * @brief   Constructor. Builds the index with a depth-first walk from the first open cell.
+ *          Every cell, that isn't a wall, is part of the tree, so the maze must be perfect:
+ *          every open cell is connected and there are no loops.
+ * @param   vect - View of the maze. It isn't changed and isn't needed after the constructor.
+ * @return  void
+ */
+maze::tree_index::tree_index(grid_view vect) : height(vect.get_height()), width(vect.get_width())
+{
+  size_t cells = static_cast<size_t>(height)*width;
+  /* Every cell is stored as y*width+x in 32 bits. */
+  if (cells >= unreached)
+  {
+    throw std::invalid_argument("The maze is too big for the index.");
+  }
+
+  depth.assign(cells, static_cast<uint32_t>(unreached));
+  first.assign(cells, 0u);
+  back.assign((cells+3u)/4u, 0u);
+
+  /* The root is the first open cell. */
+  uint32_t root = unreached;
+  size_t open_cells = 0u;
+  for (uint32_t y = 0u; y < height; y++)
+  {
+    for (uint32_t x = 0u; x < width; x++)
+    {
+      if (wall != vect(y, x))
+      {
+        root = (unreached == root) ? (y*width+x) : root;
+        open_cells++;
+      }
+    }
+  }
+  if (unreached == root)
+  {
+    throw std::invalid_argument("The maze has no open cells.");
+  }
+  euler.reserve(open_cells*2u);
+
+  /* Depth-first walk without recursion. Every cell goes into the tour, when it is reached and after each of its children. */
+  struct step {
+    uint32_t y;
+    uint32_t x;
+    uint8_t next_direction;
+  };
+  static constexpr int32_t step_y[4u] = {-1, 1, 0, 0};
+  static constexpr int32_t step_x[4u] = {0, 0, -1, 1};
+  std::vector<step> stack;
+  size_t reached = 1u;
+
+  depth[root] = 0u;
+  first[root] = 0u;
+  euler.push_back(root);
+  stack.push_back({root/width, root%width, north});
+
+  while (!stack.empty())
+  {
+    step &current = stack.back();
+    if (4u == current.next_direction)
+    {
+      stack.pop_back();
+      if (!stack.empty())
+      {
+        euler.push_back(stack.back().y*width+stack.back().x);
+      }
+      continue;
+    }
+
+    uint8_t direction = current.next_direction++;
+    uint32_t y = current.y+step_y[direction];
+    uint32_t x = current.x+step_x[direction];
+    uint32_t current_cell = current.y*width+current.x;
+    /* Going out of the maze wraps around to a too big coordinate. */
+    if ((y >= height) || (x >= width) || (wall == vect(y, x)))
+    {
+      continue;
+    }
+
+    uint32_t next_cell = y*width+x;
+    if (unreached == depth[next_cell])
+    {
+      depth[next_cell] = depth[current_cell]+1u;
+      back[next_cell/4u] |= static_cast<uint8_t>((direction ^ 1u) << ((next_cell%4u)*2u));
+      first[next_cell] = static_cast<uint32_t>(euler.size());
+      euler.push_back(next_cell);
+      reached++;
+      stack.push_back({y, x, north});
+    }
+    else if ((current_cell == root) || (next_cell != parent(current_cell)))
+    {
+      /* Reached again, but not through the parent, so there is a loop. */
+      throw std::invalid_argument("The maze has loops, it isn't perfect.");
+    }
+    else
+    {
+      /* Do nothing. */
+    }
+  }
+
+  if (reached != open_cells)
+  {
+    throw std::invalid_argument("Some cells aren't connected, the maze isn't perfect.");
+  }
+
+  /* The depths of the tour, then the minimum of every block, then of every 2, 4, 8, ... blocks. */
+  euler_depth.resize(euler.size());
+  for (size_t i = 0u; i < euler.size(); i++)
+  {
+    euler_depth[i] = depth[euler[i]];
+  }
+  uint32_t blocks = static_cast<uint32_t>((euler.size()+block-1u)/block);
+  table.assign(1u, std::vector<uint32_t>(blocks));
+  for (uint32_t i = 0u; i < blocks; i++)
+  {
+    uint32_t best = i*block;
+    uint32_t last = std::min(static_cast<uint32_t>(euler.size()), (i+1u)*block);
+    for (uint32_t j = best+1u; j < last; j++)
+    {
+      best = (euler_depth[j] < euler_depth[best]) ? j : best;
+    }
+    table[0u][i] = best;
+  }
+  for (uint32_t level = 1u; (1u << level) <= blocks; level++)
+  {
+    const std::vector<uint32_t> &previous = table[level-1u];
+    std::vector<uint32_t> current(blocks-(1u << level)+1u);
+    for (uint32_t i = 0u; i < current.size(); i++)
+    {
+      uint32_t left = previous[i];
+      uint32_t right = previous[i+(1u << (level-1u))];
+      current[i] = (euler_depth[right] < euler_depth[left]) ? right : left;
+    }
+    table.push_back(std::move(current));
+  }
+}
+
+/**
+ * @brief   Returns the length of the path (number of steps) between two cells.
+ * @param   from_y  - Y coordinate of the first cell.
+ * @param   from_x  - X coordinate of the first cell.
+ * @param   to_y    - Y coordinate of the second cell.
+ * @param   to_x    - X coordinate of the second cell.
+ * @return  Number of steps.
+ */
+uint64_t maze::tree_index::distance(uint32_t from_y, uint32_t from_x, uint32_t to_y, uint32_t to_x)
+{
+  uint32_t from = cell(from_y, from_x);
+  uint32_t to = cell(to_y, to_x);
+  uint32_t ancestor = lowest_common_ancestor(from, to);
+  return static_cast<uint64_t>(depth[from])+depth[to]-2u*static_cast<uint64_t>(depth[ancestor]);
+}
+
+/**
+ * @brief   Lists the path between two cells. It takes as many steps, as long the path is.
+ * @param   from_y  - Y coordinate of the first cell.
+ * @param   from_x  - X coordinate of the first cell.
+ * @param   to_y    - Y coordinate of the second cell.
+ * @param   to_x    - X coordinate of the second cell.
+ * @param   &route  - Every [y,x] of the path, from the first cell to the second one.
+ * @return  void
+ */
+void maze::tree_index::path(uint32_t from_y, uint32_t from_x, uint32_t to_y, uint32_t to_x, std::vector<solver::coordinate> &route)
+{
+  uint32_t from = cell(from_y, from_x);
+  uint32_t to = cell(to_y, to_x);
+  uint32_t ancestor = lowest_common_ancestor(from, to);
+
+  /* Up from the first cell to the common ancestor, then up from the second one, backwards. */
+  route.clear();
+  route.reserve(static_cast<size_t>(depth[from])+depth[to]-2u*depth[ancestor]+1u);
+  for (uint32_t current = from; current != ancestor; current = parent(current))
+  {
+    route.push_back({current/width, current%width});
+  }
+  size_t middle = route.size();
+  for (uint32_t current = to; current != ancestor; current = parent(current))
+  {
+    route.push_back({current/width, current%width});
+  }
+  route.push_back({ancestor/width, ancestor%width});
+  std::reverse(route.begin()+middle, route.end());
+}
+
+/**
+ * @brief   Returns the height of the indexed maze.
+ * @param   void
+ * @return  height
+ */
+uint32_t maze::tree_index::get_height(void)
+{
+  return height;
+}
+
+/**
+ * @brief   Returns the width of the indexed maze.
+ * @param   void
+ * @return  width
+ */
+uint32_t maze::tree_index::get_width(void)
+{
+  return width;
+}
+
+/**
+ * @brief   Checks a coordinate and returns its cell.
+ * @param   y - Y coordinate.
+ * @param   x - X coordinate.
+ * @return  y*width+x
+ */
+uint32_t maze::tree_index::cell(uint32_t y, uint32_t x)
+{
+  if ((height <= y) || (width <= x))
+  {
+    throw std::invalid_argument("Out of boundary!");
+  }
+  if (unreached == depth[y*width+x])
+  {
+    throw std::invalid_argument("The cell is a wall.");
+  }
+  return y*width+x;
+}
+
+/**
+ * @brief   Returns the parent of a cell (the next cell towards the root).
+ * @param   cell - The cell, it can't be the root.
+ * @return  The parent.
+ */
+uint32_t maze::tree_index::parent(uint32_t cell)
+{
+  uint8_t direction = (back[cell/4u] >> ((cell%4u)*2u)) & 3u;
+  if (north == direction)
+  {
+    return cell-width;
+  }
+  else if (south == direction)
+  {
+    return cell+width;
+  }
+  else if (west == direction)
+  {
+    return cell-1u;
+  }
+  else
+  {
+    return cell+1u;
+  }
+}
+
+/**
+ * @brief   Returns the deepest cell, that is an ancestor of both cells.
+ *          It is the cell with the smallest depth in the tour, between the first appearance of the two cells.
+ * @param   first_cell  - The first cell.
+ * @param   second_cell - The second cell.
+ * @return  The common ancestor.
+ */
+uint32_t maze::tree_index::lowest_common_ancestor(uint32_t first_cell, uint32_t second_cell)
+{
+  uint32_t left = std::min(first[first_cell], first[second_cell]);
+  uint32_t right = std::max(first[first_cell], first[second_cell]);
+  return euler[minimum(left, right)];
+}
+
+/**
+ * @brief   Returns the position of the smallest depth in the tour, between left and right (both included).
+ *          The partial blocks on the two sides are searched, the whole blocks between them come from the table.
+ * @param   left  - First position.
+ * @param   right - Last position.
+ * @return  Position of the minimum.
+ */
+uint32_t maze::tree_index::minimum(uint32_t left, uint32_t right)
+{
+  uint32_t left_block = left/block;
+  uint32_t right_block = right/block;
+  uint32_t best = left;
+
+  if (left_block == right_block)
+  {
+    for (uint32_t i = left+1u; i <= right; i++)
+    {
+      best = (euler_depth[i] < euler_depth[best]) ? i : best;
+    }
+    return best;
+  }
+
+  for (uint32_t i = left+1u; i < (left_block+1u)*block; i++)
+  {
+    best = (euler_depth[i] < euler_depth[best]) ? i : best;
+  }
+  for (uint32_t i = right_block*block; i <= right; i++)
+  {
+    best = (euler_depth[i] < euler_depth[best]) ? i : best;
+  }
+  if ((left_block+1u) < right_block)
+  {
+    /* Two overlapping ranges of 2^level blocks cover the whole blocks. */
+    uint32_t count = right_block-left_block-1u;
+    uint32_t level = 0u;
+    while ((2u << level) <= count)
+    {
+      level++;
+    }
+    uint32_t from_left = table[level][left_block+1u];
+    uint32_t from_right = table[level][right_block-(1u << level)];
+    best = (euler_depth[from_left] < euler_depth[best]) ? from_left : best;
+    best = (euler_depth[from_right] < euler_depth[best]) ? from_right : best;
+  }
+  return best;
+}
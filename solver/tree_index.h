@@ -0,0 +1,63 @@
+/**
+ * @file    tree_index.h
+ * @author  Ferenc Nemeth
+ * @date    17 Oct 2026
+ * @brief   Index of a perfect maze for fast path queries between any two cells.
+ *
+ *          Copyright (c) 2026 Ferenc Nemeth - https://github.com/ferenc-nemeth/
+ */ 
+
+#ifndef TREE_INDEX_H_
+#define TREE_INDEX_H_
+
+#include <vector>
+#include <stdexcept>
+#include "solver.h"
+
+namespace maze
+{
+  /**
+   * A perfect maze is a tree: there is exactly one path between any two cells.
+   * The index is built once (parents, depths, Euler tour and a table of minimums over it),
+   * then the path between two cells goes through their lowest common ancestor.
+   * The length of a path takes O(log n), listing it takes as many steps, as long the path is.
+   */
+  class tree_index
+  {
+    public:
+      explicit tree_index(grid_view vect);
+
+      uint64_t distance(uint32_t from_y, uint32_t from_x, uint32_t to_y, uint32_t to_x);
+      void path(uint32_t from_y, uint32_t from_x, uint32_t to_y, uint32_t to_x, std::vector<solver::coordinate> &route);
+
+      uint32_t get_height(void);
+      uint32_t get_width(void);
+
+    private:
+      static constexpr uint8_t wall   = maze_generator::wall;
+      static constexpr uint8_t north  = 0u;
+      static constexpr uint8_t south  = 1u;
+      static constexpr uint8_t west   = 2u;
+      static constexpr uint8_t east   = 3u;
+
+      static constexpr uint32_t unreached = UINT32_MAX;
+      static constexpr uint32_t block     = 64u; /**< Minimums inside a block are searched, between blocks they come from the table. */
+
+      uint32_t height;
+      uint32_t width;
+
+      std::vector<uint32_t> depth;            /**< Distance of every cell from the root, unreached for walls. */
+      std::vector<uint32_t> first;            /**< First position of every cell in the Euler tour. */
+      std::vector<uint8_t> back;              /**< Two bits per cell: the direction to the parent. */
+      std::vector<uint32_t> euler;            /**< Cells in the order of the tour, every cell is there after each of its children. */
+      std::vector<uint32_t> euler_depth;      /**< Depths of the tour, next to each other for the searches. */
+      std::vector<std::vector<uint32_t>> table; /**< Position of the minimum depth in 2^level blocks from every block. */
+
+      uint32_t cell(uint32_t y, uint32_t x);
+      uint32_t parent(uint32_t cell);
+      uint32_t lowest_common_ancestor(uint32_t first_cell, uint32_t second_cell);
+      uint32_t minimum(uint32_t left, uint32_t right);
+  };
+}
+
+#endif /* TREE_INDEX_H_ */